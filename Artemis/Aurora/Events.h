@@ -31,12 +31,306 @@
 
 #include "Definitions.h"
 
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <type_traits>
+
 namespace Aurora {
-	template<typename T, typename... U>
-	A_ADDR GetAddressOfFunction(Function<T(U...)> lpfnFunction) {
-		typedef T(fnType)(U...);
-		fnType** fnPointer = lpfnFunction.template target<fnType*>();
-		return (A_ADDR)*fnPointer;
+	/// <summary>
+	/// The threads an event handler may be called on when its event is invoked asynchronously.
+	/// </summary>
+	enum class EventHandlerAffinity : A_I32 {
+		RenderThread,	// The handler is only called on the render thread. The default, since it is where events were always invoked.
+		AnyThread		// The handler may be called on any thread, including concurrently with other handlers.
+	};
+
+	template<typename Signature>
+	class Delegate;
+
+	/// <summary>
+	/// <para>A callable wrapper like Function, that stores callables of up to c_uInlineSize bytes inside itself instead of on the heap.</para>
+	/// <para>Larger callables, and callables that may throw when moved, are still stored on the heap.</para>
+	/// </summary>
+	/// <typeparam name="R">- The return type of the callable.</typeparam>
+	/// <typeparam name="Args">- The parameter types of the callable.</typeparam>
+	template<typename R, typename... Args>
+	class Delegate<R(Args...)> {
+	public:
+		static constexpr A_U64 c_uInlineSize = 32;
+		static constexpr A_U64 c_uInlineAlignment = 16;
+
+	private:
+		enum class Operation { Copy, Move, Destroy };
+
+		using Invoker = R(*)(_In_ A_BYTE* lpStorage, Args... args);
+		using Manager = A_VOID(*)(_In_ Operation Op, _Out_opt_ A_BYTE* lpDestination, _Inout_ A_BYTE* lpSource);
+
+		template<typename F>
+		static constexpr A_BOOL IsInline = sizeof(F) <= c_uInlineSize && alignof(F) <= c_uInlineAlignment && std::is_nothrow_move_constructible_v<F>;
+
+		template<typename F>
+		static R InvokeInline(_In_ A_BYTE* lpStorage, Args... args) { return (*std::launder(reinterpret_cast<F*>(lpStorage)))(std::forward<Args>(args)...); }
+
+		template<typename F>
+		static R InvokeHeap(_In_ A_BYTE* lpStorage, Args... args) { return (**reinterpret_cast<F**>(lpStorage))(std::forward<Args>(args)...); }
+
+		template<typename F>
+		static A_VOID ManageInline(_In_ Operation Op, _Out_opt_ A_BYTE* lpDestination, _Inout_ A_BYTE* lpSource) {
+			F* pSource = std::launder(reinterpret_cast<F*>(lpSource));
+
+			switch (Op) {
+			case Operation::Copy: new (lpDestination) F(*pSource); break;
+			case Operation::Move: new (lpDestination) F(std::move(*pSource)); pSource->~F(); break;
+			case Operation::Destroy: pSource->~F(); break;
+			}
+		}
+
+		template<typename F>
+		static A_VOID ManageHeap(_In_ Operation Op, _Out_opt_ A_BYTE* lpDestination, _Inout_ A_BYTE* lpSource) {
+			F* pSource = *reinterpret_cast<F**>(lpSource);
+
+			switch (Op) {
+			case Operation::Copy: *reinterpret_cast<F**>(lpDestination) = new F(*pSource); break;
+			case Operation::Move: *reinterpret_cast<F**>(lpDestination) = pSource; break;
+			case Operation::Destroy: delete pSource; break;
+			}
+		}
+
+		alignas(c_uInlineAlignment) mutable A_BYTE szStorage[c_uInlineSize];
+		Invoker pfnInvoke;	// Null if the delegate is empty.
+		Manager pfnManage;	// Null if the callable is stored inline and trivially copyable, in which case it is copied as bytes.
+
+		A_VOID Reset() noexcept {
+			if (pfnManage) pfnManage(Operation::Destroy, nullptr, szStorage);
+			pfnInvoke = nullptr;
+			pfnManage = nullptr;
+		}
+
+		A_VOID CopyFrom(_In_ const Delegate& refOther) {
+			if (refOther.pfnManage) refOther.pfnManage(Operation::Copy, szStorage, refOther.szStorage);
+			else memcpy(szStorage, refOther.szStorage, c_uInlineSize);
+			pfnInvoke = refOther.pfnInvoke;
+			pfnManage = refOther.pfnManage;
+		}
+
+		A_VOID MoveFrom(_Inout_ Delegate& refOther) noexcept {
+			if (refOther.pfnManage) refOther.pfnManage(Operation::Move, szStorage, refOther.szStorage);
+			else memcpy(szStorage, refOther.szStorage, c_uInlineSize);
+			pfnInvoke = refOther.pfnInvoke;
+			pfnManage = refOther.pfnManage;
+			refOther.pfnInvoke = nullptr;
+			refOther.pfnManage = nullptr;
+		}
+
+	public:
+		constexpr Delegate() noexcept : szStorage(), pfnInvoke(nullptr), pfnManage(nullptr) {}
+		constexpr Delegate(std::nullptr_t) noexcept : Delegate() {}
+
+		template<typename F>
+			requires(!std::is_same_v<std::decay_t<F>, Delegate> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+		Delegate(F&& Callable) : Delegate() {
+			using Stored = std::decay_t<F>;
+
+			if constexpr (std::is_pointer_v<Stored> || std::is_member_pointer_v<Stored>)
+				if (!Callable) return;
+
+			if constexpr (IsInline<Stored>) {
+				new (szStorage) Stored(std::forward<F>(Callable));
+				pfnInvoke = &InvokeInline<Stored>;
+				if constexpr (!std::is_trivially_copyable_v<Stored>)
+					pfnManage = &ManageInline<Stored>;
+			}
+			else {
+				*reinterpret_cast<Stored**>(szStorage) = new Stored(std::forward<F>(Callable));
+				pfnInvoke = &InvokeHeap<Stored>;
+				pfnManage = &ManageHeap<Stored>;
+			}
+		}
+
+		Delegate(_In_ const Delegate& refOther) : Delegate() { CopyFrom(refOther); }
+		Delegate(_Inout_ Delegate&& refOther) noexcept : Delegate() { MoveFrom(refOther); }
+
+		Delegate& operator=(_In_ const Delegate& refOther) {
+			if (this != &refOther) {
+				Reset();
+				CopyFrom(refOther);
+			}
+			return *this;
+		}
+
+		Delegate& operator=(_Inout_ Delegate&& refOther) noexcept {
+			if (this != &refOther) {
+				Reset();
+				MoveFrom(refOther);
+			}
+			return *this;
+		}
+
+		Delegate& operator=(std::nullptr_t) noexcept {
+			Reset();
+			return *this;
+		}
+
+		~Delegate() { Reset(); }
+
+		/// <summary>
+		/// Checks whether the delegate holds the given function pointer.
+		/// </summary>
+		/// <param name="lpfnFunction">- The function pointer to compare with.</param>
+		/// <returns>True if the delegate was made from the same function pointer, otherwise false.</returns>
+		template<FunctionPtrType F>
+		AURORA_NDWR_GET("Targets") A_BOOL Targets(_In_ F lpfnFunction) const noexcept {
+			return pfnInvoke == &InvokeInline<F> && !memcmp(szStorage, &lpfnFunction, sizeof(F));
+		}
+
+		explicit operator A_BOOL() const noexcept { return pfnInvoke != nullptr; }
+
+		R operator()(Args... args) const { return pfnInvoke(szStorage, std::forward<Args>(args)...); }
+	};
+
+	/// <summary>
+	/// A handle to a subscribed event handler, used to unsubscribe it again.
+	/// A subscription becomes stale once its handler is unsubscribed, even if its slot is reused.
+	/// </summary>
+	struct EventSubscription {
+		A_U32 uSlot;
+		A_U32 uGeneration;
+
+		constexpr EventSubscription() noexcept : uSlot(MAX_INVOKE), uGeneration(0) {}
+		constexpr EventSubscription(_In_ A_U32 uSlot, _In_ A_U32 uGeneration) noexcept : uSlot(uSlot), uGeneration(uGeneration) {}
+
+		AURORA_NDWR_GET("IsValid") constexpr A_BOOL IsValid() const noexcept { return uSlot < MAX_INVOKE; }
+
+		constexpr A_BOOL operator==(const EventSubscription&) const noexcept = default;
+	};
+
+	namespace Helpers {
+		/// <summary>
+		/// <para>The handler storage shared by the event classes.</para>
+		/// <para>Handlers are packed at the front of the array, so invoking only visits the live ones. Each subscription maps to the index of its handler, so unsubscribing moves the last handler into the gap instead of searching for it.</para>
+		/// <para>The handlers are guarded by a reader-writer lock, so they may be subscribed and unsubscribed on any thread while the event is invoked on others. Invoking holds the lock shared until the last handler returns, so handlers must not subscribe to, unsubscribe from or invoke the event that is invoking them.</para>
+		/// </summary>
+		/// <typeparam name="Signature">- The signature of the event handlers.</typeparam>
+		template<typename Signature>
+		class EventHandlers {
+		public:
+			using Handler = Delegate<Signature>;
+
+		protected:
+			Handler szHandlers[MAX_INVOKE];
+			EventHandlerAffinity szAffinities[MAX_INVOKE];
+			A_U32 szSlots[MAX_INVOKE];			// The subscription slot of each handler.
+			A_U32 szIndices[MAX_INVOKE];		// The index of the handler of each subscription slot, or MAX_INVOKE if the slot is free.
+			A_U32 szGenerations[MAX_INVOKE];	// The generation of each subscription slot.
+			A_U32 uCount;
+			mutable std::shared_mutex Lock;
+
+			// Expects the lock to be held exclusively.
+			A_VOID Remove(_In_ A_U32 uIndex) noexcept {
+				A_U32 uSlot = szSlots[uIndex];
+				A_U32 uLast = --uCount;
+
+				if (uIndex != uLast) {
+					szHandlers[uIndex] = std::move(szHandlers[uLast]);
+					szAffinities[uIndex] = szAffinities[uLast];
+					szSlots[uIndex] = szSlots[uLast];
+					szIndices[szSlots[uIndex]] = uIndex;
+				}
+				szHandlers[uLast] = nullptr;
+
+				szIndices[uSlot] = MAX_INVOKE;
+				szGenerations[uSlot]++;
+			}
+
+		public:
+			EventHandlers() noexcept : uCount(0) {
+				for (A_U32 i = 0; i < MAX_INVOKE; i++) {
+					szIndices[i] = MAX_INVOKE;
+					szGenerations[i] = 0;
+				}
+			}
+
+			/// <summary>
+			/// Checks whether any event handler with the given affinity is registered.
+			/// </summary>
+			/// <param name="Affinity">- The affinity to check for.</param>
+			/// <returns>True if there is such a handler, otherwise false.</returns>
+			AURORA_NDWR_GET("HasHandlers") A_BOOL HasHandlers(_In_ EventHandlerAffinity Affinity) const noexcept {
+				std::shared_lock<std::shared_mutex> Guard(Lock);
+				for (A_U32 i = 0; i < uCount; i++)
+					if (szAffinities[i] == Affinity)
+						return true;
+				return false;
+			}
+
+			/// <summary>
+			/// Clears the list of registered event handlers.
+			/// </summary>
+			A_VOID Clear() noexcept {
+				std::lock_guard<std::shared_mutex> Guard(Lock);
+				for (A_U32 i = 0; i < uCount; i++) {
+					szHandlers[i] = nullptr;
+					szIndices[szSlots[i]] = MAX_INVOKE;
+					szGenerations[szSlots[i]]++;
+				}
+				uCount = 0;
+			}
+
+			/// <summary>
+			/// Registers an event handler with the given affinity.
+			/// </summary>
+			/// <param name="Callable">- The event handler.</param>
+			/// <param name="Affinity">- The threads the handler may be called on when the event is invoked asynchronously.</param>
+			/// <returns>The subscription of the handler, which is invalid if the handler is empty or the event already has MAX_INVOKE handlers.</returns>
+			EventSubscription Subscribe(_In_ Handler Callable, _In_ EventHandlerAffinity Affinity) {
+				if (!Callable) return EventSubscription();
+
+				std::lock_guard<std::shared_mutex> Guard(Lock);
+				if (uCount == MAX_INVOKE) return EventSubscription();
+
+				A_U32 uSlot = 0;
+				while (szIndices[uSlot] != MAX_INVOKE) uSlot++;
+
+				szHandlers[uCount] = std::move(Callable);
+				szAffinities[uCount] = Affinity;
+				szSlots[uCount] = uSlot;
+				szIndices[uSlot] = uCount++;
+
+				return EventSubscription(uSlot, szGenerations[uSlot]);
+			}
+
+			/// <summary>
+			/// Unregisters the event handler of a subscription.
+			/// </summary>
+			/// <param name="Subscription">- The subscription returned when the handler was registered.</param>
+			/// <returns>True if the handler was unregistered, false if the subscription is stale.</returns>
+			A_BOOL Unsubscribe(_In_ EventSubscription Subscription) noexcept {
+				if (!Subscription.IsValid()) return false;
+
+				std::lock_guard<std::shared_mutex> Guard(Lock);
+				if (szIndices[Subscription.uSlot] == MAX_INVOKE || szGenerations[Subscription.uSlot] != Subscription.uGeneration) return false;
+
+				Remove(szIndices[Subscription.uSlot]);
+				return true;
+			}
+
+			EventSubscription operator+=(_In_ Handler Callable) { return Subscribe(std::move(Callable), EventHandlerAffinity::RenderThread); }
+
+			A_BOOL operator-=(_In_ EventSubscription Subscription) noexcept { return Unsubscribe(Subscription); }
+
+			/// <summary>
+			/// Unregisters every event handler that was registered as the given function pointer.
+			/// </summary>
+			template<FunctionPtrType F>
+			A_VOID operator-=(_In_ F lpfnEventHandler) noexcept {
+				std::lock_guard<std::shared_mutex> Guard(Lock);
+				for (A_U32 i = uCount; i-- > 0;)
+					if (szHandlers[i].Targets(lpfnEventHandler))
+						Remove(i);
+			}
+		};
 	}
 
 	/// <summary>
@@ -44,89 +338,74 @@ namespace Aurora {
 	/// </summary>
 	/// <typeparam name="InstanceEventArgs">- A class or struct containing event arguments.</typeparam>
 	template<ClassType InstanceEventArgs = NullClass_t>
-	class Event {
-		Function<A_VOID(_In_opt_ A_LPVOID lpSender, _In_opt_ const InstanceEventArgs* lpEventArgs)> lpszfnEventHandlers[MAX_INVOKE];
-
+	class Event : public Helpers::EventHandlers<A_VOID(_In_opt_ A_LPVOID lpSender, _In_opt_ const InstanceEventArgs* lpEventArgs)> {
 	public:
-		Event() noexcept {
-			for (A_I32 i = 0; i < MAX_INVOKE; i++) lpszfnEventHandlers[i] = nullptr;
-		}
-
 		/// <summary>
 		/// Invokes all registered event handlers.
 		/// </summary>
 		/// <param name="lpSender">- A pointer to the sender. Can be null.</param>
 		/// <param name="lpArgs">- A pointer to an instance of the event args.</param>
 		A_VOID Invoke(_In_opt_ A_LPVOID lpSender, _In_opt_ const InstanceEventArgs* lpArgs) const {
-			for (A_I32 i = 0; i < MAX_INVOKE; i++)
-				if (lpszfnEventHandlers[i] != nullptr)
-					lpszfnEventHandlers[i](lpSender, lpArgs);
+			std::shared_lock<std::shared_mutex> Guard(this->Lock);
+			for (A_U32 i = 0; i < this->uCount; i++)
+				this->szHandlers[i](lpSender, lpArgs);
 		}
 
 		/// <summary>
-		/// Clears the list of registered event handlers.
+		/// Invokes the registered event handlers with the given affinity.
 		/// </summary>
-		A_VOID Clear() noexcept {
-			for (A_I32 i = 0; i < MAX_INVOKE; i++) lpszfnEventHandlers[i] = nullptr;
-		}
-
-		A_VOID operator+=(_In_ Function<A_VOID(_In_opt_ A_LPVOID lpSender, _In_opt_ const InstanceEventArgs* lpEventArgs)> lpfnEventHandler) noexcept {
-			for (A_I32 i = 0; i < MAX_INVOKE; i++)
-				if (lpszfnEventHandlers[i] == nullptr) {
-					lpszfnEventHandlers[i] = lpfnEventHandler;
-					break;
-				}
+		/// <param name="lpSender">- A pointer to the sender. Can be null.</param>
+		/// <param name="lpArgs">- A pointer to an instance of the event args.</param>
+		/// <param name="Affinity">- The affinity of the handlers to invoke.</param>
+		A_VOID Invoke(_In_opt_ A_LPVOID lpSender, _In_opt_ const InstanceEventArgs* lpArgs, _In_ EventHandlerAffinity Affinity) const {
+			std::shared_lock<std::shared_mutex> Guard(this->Lock);
+			for (A_U32 i = 0; i < this->uCount; i++)
+				if (this->szAffinities[i] == Affinity)
+					this->szHandlers[i](lpSender, lpArgs);
 		}
 
-		A_VOID operator-=(_In_ Function<A_VOID(_In_opt_ A_LPVOID lpSender, _In_opt_ const InstanceEventArgs* lpEventArgs)> lpfnEventHandler) noexcept {
-			for (A_I32 i = 0; i < MAX_INVOKE; i++)
-				if (GetAddressOfFunction(lpszfnEventHandlers[i]) == GetAddressOfFunction(lpfnEventHandler))
-					lpszfnEventHandlers[i] = nullptr;
-		}
+		/// <summary>
+		/// Invokes the event through a queue, which calls the handlers later on the threads their affinities allow.
+		/// </summary>
+		/// <typeparam name="Queue">- A queue with an Enqueue member taking the event, the sender and the event args.</typeparam>
+		template<class Queue>
+		A_VOID InvokeAsync(_Inout_ Queue& refQueue, _In_opt_ A_LPVOID lpSender, _In_opt_ const InstanceEventArgs* lpArgs) const { refQueue.Enqueue(*this, lpSender, lpArgs); }
 	};
 
 	/// <summary>
 	/// A class for subscribing and invoking to events.
 	/// </summary>
 	template<>
-	class Event<NullClass_t> {
-		Function<A_VOID(A_LPVOID lpSender)> lpszfnEventHandlers[MAX_INVOKE];
-
+	class Event<NullClass_t> : public Helpers::EventHandlers<A_VOID(A_LPVOID lpSender)> {
 	public:
-		Event() noexcept {
-			for (A_I32 i = 0; i < MAX_INVOKE; i++) lpszfnEventHandlers[i] = nullptr;
-		}
-
 		/// <summary>
 		/// Invokes all registered event handlers.
 		/// </summary>
 		/// <param name="lpSender">- A pointer to the sender. Can be null.</param>
 		A_VOID Invoke(_In_opt_ A_LPVOID lpSender) const {
-			for (A_I32 i = 0; i < MAX_INVOKE; i++)
-				if (lpszfnEventHandlers[i] != nullptr)
-					lpszfnEventHandlers[i](lpSender);
+			std::shared_lock<std::shared_mutex> Guard(Lock);
+			for (A_U32 i = 0; i < uCount; i++)
+				szHandlers[i](lpSender);
 		}
 
 		/// <summary>
-		/// Clears the list of registered event handlers.
+		/// Invokes the registered event handlers with the given affinity.
 		/// </summary>
-		A_VOID Clear() noexcept {
-			for (A_I32 i = 0; i < MAX_INVOKE; i++) lpszfnEventHandlers[i] = nullptr;
-		}
-
-		A_VOID operator+=(_In_ Function<A_VOID(_In_opt_ A_LPVOID lpSender)> lpfnEventHandler) noexcept {
-			for (A_I32 i = 0; i < MAX_INVOKE; i++)
-				if (lpszfnEventHandlers[i] == nullptr) {
-					lpszfnEventHandlers[i] = lpfnEventHandler;
-					break;
-				}
+		/// <param name="lpSender">- A pointer to the sender. Can be null.</param>
+		/// <param name="Affinity">- The affinity of the handlers to invoke.</param>
+		A_VOID Invoke(_In_opt_ A_LPVOID lpSender, _In_ EventHandlerAffinity Affinity) const {
+			std::shared_lock<std::shared_mutex> Guard(Lock);
+			for (A_U32 i = 0; i < uCount; i++)
+				if (szAffinities[i] == Affinity)
+					szHandlers[i](lpSender);
 		}
 
-		A_VOID operator-=(_In_ Function<A_VOID(_In_opt_ A_LPVOID lpSender)> lpfnEventHandler) noexcept {
-			for (A_I32 i = 0; i < MAX_INVOKE; i++)
-				if (GetAddressOfFunction(lpszfnEventHandlers[i]) == GetAddressOfFunction(lpfnEventHandler))
-					lpszfnEventHandlers[i] = nullptr;
-		}
+		/// <summary>
+		/// Invokes the event through a queue, which calls the handlers later on the threads their affinities allow.
+		/// </summary>
+		/// <typeparam name="Queue">- A queue with an Enqueue member taking the event and the sender.</typeparam>
+		template<class Queue>
+		A_VOID InvokeAsync(_Inout_ Queue& refQueue, _In_opt_ A_LPVOID lpSender) const { refQueue.Enqueue(*this, lpSender); }
 	};
 }
 
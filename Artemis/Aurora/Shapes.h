@@ -322,6 +322,32 @@ namespace Aurora {
 		/// <returns>The circle diameter.</returns>
 		AURORA_NDWR_PURE("Diameter") constexpr A_I32 Diameter() const noexcept { return nRadius * 2; }
 	};
+
+	struct Text {
+		Point ptPosition; // The top left point of the text.
+		A_LPCSTR lpText; // The null-terminated UTF-8 string to draw. The shape does not own it.
+		RGBA Color; // The color of the text.
+		A_FL32 fSize; // The font size in pixels, or 0 to use the size of the current font.
+
+		constexpr Text() noexcept : ptPosition(), lpText(nullptr), Color(), fSize(0) {}
+
+		/// <summary>
+		/// Constructs a Text.
+		/// </summary>
+		/// <param name="ptPosition">- The top left point of the text.</param>
+		/// <param name="lpText">- The null-terminated UTF-8 string to draw.</param>
+		/// <param name="Color">- The color of the text.</param>
+		/// <param name="fSize">- The font size in pixels, or 0 to use the size of the current font.</param>
+		constexpr Text(
+			_In_ const Point& ptPosition,
+			_In_z_ A_LPCSTR lpText,
+			_In_ const RGBA& Color,
+			_In_ const A_FL32 fSize = 0.0f
+		) noexcept : ptPosition(ptPosition),
+			lpText(lpText),
+			Color(Color),
+			fSize(fSize) {}
+	};
 }
 
 #endif // !__AURORA_SHAPES_H__
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "Conversions.h"
+
+#include <immintrin.h>
+
+#if defined(__AVX2__)
+#define ARTEMIS_SIMD_AVX2
+#define ARTEMIS_SIMD_SSE2
+#elif defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define ARTEMIS_SIMD_SSE2
+#endif
+
+namespace Artemis {
+	namespace Helpers {
+		void IntegersToFloats(_In_reads_(uCount) const A_I32* pIntegers, _Out_writes_(uCount) A_FL32* pFloats, _In_ size_t uCount) noexcept {
+			size_t i = 0;
+
+#if defined(ARTEMIS_SIMD_AVX2)
+			for (; i + 8 <= uCount; i += 8)
+				_mm256_storeu_ps(&pFloats[i], _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&pIntegers[i]))));
+#endif // ARTEMIS_SIMD_AVX2
+
+#if defined(ARTEMIS_SIMD_SSE2)
+			for (; i + 4 <= uCount; i += 4)
+				_mm_storeu_ps(&pFloats[i], _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&pIntegers[i]))));
+#endif // ARTEMIS_SIMD_SSE2
+
+			for (; i < uCount; i++)
+				pFloats[i] = static_cast<A_FL32>(pIntegers[i]);
+		}
+
+		void ChannelsToU32(_In_ const A_FL32* pChannels, _Out_writes_(uCount) A_U32* pPacked, _In_ size_t uCount, _In_ size_t uStride) noexcept {
+			const A_BYTE* lpColors = reinterpret_cast<const A_BYTE*>(pChannels);
+			size_t i = 0;
+
+#if defined(ARTEMIS_SIMD_SSE2)
+			// Clamping before the conversion saturates values outside of the int32 range, and maxps returns its second operand for NaN.
+			// The conversion rounds to nearest even under the default MXCSR, like ChannelToU8.
+			auto Convert = [](_In_ const A_BYTE* lpColor) noexcept {
+				__m128 vColor = _mm_loadu_ps(reinterpret_cast<const float*>(lpColor));
+				return _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(vColor, _mm_setzero_ps()), _mm_set1_ps(255.0F)));
+			};
+
+#if defined(ARTEMIS_SIMD_AVX2)
+			const __m256i vOrder = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+			auto ConvertPair = [uStride](_In_ const A_BYTE* lpColor) noexcept {
+				__m256 vColors = _mm256_set_m128(_mm_loadu_ps(reinterpret_cast<const float*>(lpColor + uStride)), _mm_loadu_ps(reinterpret_cast<const float*>(lpColor)));
+				return _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(vColors, _mm256_setzero_ps()), _mm256_set1_ps(255.0F)));
+			};
+
+			for (; i + 8 <= uCount; i += 8) {
+				const A_BYTE* lpColor = lpColors + i * uStride;
+				__m256i vLow = _mm256_packs_epi32(ConvertPair(lpColor), ConvertPair(lpColor + 2 * uStride));
+				__m256i vHigh = _mm256_packs_epi32(ConvertPair(lpColor + 4 * uStride), ConvertPair(lpColor + 6 * uStride));
+
+				// Packing works within 128-bit lanes, which leaves the colors in the order 0, 2, 4, 6, 1, 3, 5, 7.
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&pPacked[i]), _mm256_permutevar8x32_epi32(_mm256_packus_epi16(vLow, vHigh), vOrder));
+			}
+#endif // ARTEMIS_SIMD_AVX2
+
+			for (; i + 4 <= uCount; i += 4) {
+				const A_BYTE* lpColor = lpColors + i * uStride;
+				__m128i vLow = _mm_packs_epi32(Convert(lpColor), Convert(lpColor + uStride));
+				__m128i vHigh = _mm_packs_epi32(Convert(lpColor + 2 * uStride), Convert(lpColor + 3 * uStride));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(&pPacked[i]), _mm_packus_epi16(vLow, vHigh));
+			}
+#endif // ARTEMIS_SIMD_SSE2
+
+			for (; i < uCount; i++) {
+				const A_FL32* pColor = reinterpret_cast<const A_FL32*>(lpColors + i * uStride);
+				pPacked[i] = ChannelsToU32(pColor[0], pColor[1], pColor[2], pColor[3]);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef __ARTEMIS_CONVERSIONS_H__
+#define __ARTEMIS_CONVERSIONS_H__
+
+#include <cstddef>
+
+#include <Aurora/Definitions.h>
+
+#include "Definitions.h"
+
+namespace Artemis {
+	namespace Helpers {
+		/// <summary>
+		/// Rounds a color channel to the nearest integer, ties to even, and saturates it to 0-255. NaN becomes 0.
+		/// </summary>
+		constexpr A_BYTE ChannelToU8(_In_ A_FL32 fChannel) noexcept {
+			if (!(fChannel > 0.0F)) return 0;
+			if (fChannel >= 255.0F) return 255;
+
+			A_BYTE uWhole = static_cast<A_BYTE>(fChannel);
+			A_FL32 fFraction = fChannel - static_cast<A_FL32>(uWhole);
+			if (fFraction > 0.5F || (fFraction == 0.5F && (uWhole & 1))) uWhole++;
+			return uWhole;
+		}
+
+		/// <summary>
+		/// Packs four channels with the first one in the lowest byte, like IM_COL32.
+		/// </summary>
+		constexpr A_U32 ChannelsToU32(_In_ A_FL32 fR, _In_ A_FL32 fG, _In_ A_FL32 fB, _In_ A_FL32 fA) noexcept {
+			return static_cast<A_U32>(ChannelToU8(fR)) | static_cast<A_U32>(ChannelToU8(fG)) << 8 | static_cast<A_U32>(ChannelToU8(fB)) << 16 | static_cast<A_U32>(ChannelToU8(fA)) << 24;
+		}
+
+		/// <summary>
+		/// Converts an array of integers to floats, using SSE2 or AVX2 where the build allows it. The results are identical to static_cast.
+		/// </summary>
+		void IntegersToFloats(_In_reads_(uCount) const A_I32* pIntegers, _Out_writes_(uCount) A_FL32* pFloats, _In_ size_t uCount) noexcept;
+
+		/// <summary>
+		/// Packs an array of colors of four float channels each, using SSE2 or AVX2 where the build allows it. The results are identical to ChannelsToU32.
+		/// </summary>
+		/// <param name="uStride">- The distance in bytes between the first channels of two colors, so that colors can be read straight out of an array of shapes.</param>
+		void ChannelsToU32(_In_ const A_FL32* pChannels, _Out_writes_(uCount) A_U32* pPacked, _In_ size_t uCount, _In_ size_t uStride = 4 * sizeof(A_FL32)) noexcept;
+	}
+}
+
+#endif // !__ARTEMIS_CONVERSIONS_H__
\ No newline at end of file
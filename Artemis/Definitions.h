@@ -11,5 +11,6 @@
 #endif // _ARTEMIS_EXPORT
 
 #define INVALID_INDEX (-1)
+#define INVALID_SLOT (0xFFFFFFFFU)
 
 #endif // !__ARTEMIS_DEFINITIONS_H__
\ No newline at end of file
@@ -1,25 +1,332 @@
 #include "pch.h"
 #include "DrawManager.h"
 
+#include <cmath>
+#include <vector>
+
+#include <immintrin.h>
+
+#include <ImGui/imgui_internal.h>
+
+#if defined(__AVX2__)
+#define ARTEMIS_SIMD_AVX2
+#define ARTEMIS_SIMD_SSE2
+#elif defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define ARTEMIS_SIMD_SSE2
+#endif
+
 namespace Artemis {
 	namespace Helpers {
 		ImVec2 PointToImVec2(_In_ const Aurora::Point& refPoint) noexcept {
 			return ImVec2(static_cast<float>(refPoint.x), static_cast<float>(refPoint.y));
 		}
 
-		constexpr ImU32 RGBAToU32(_In_ const Aurora::RGBA& refColor) noexcept {
-			ImU32 uRet = 0;
-			ImU8* pBytes = (ImU8*)&uRet;
-			pBytes[0] = static_cast<ImU8>(refColor.fR);
-			pBytes[1] = static_cast<ImU8>(refColor.fG);
-			pBytes[2] = static_cast<ImU8>(refColor.fB);
-			pBytes[3] = static_cast<ImU8>(refColor.fA);
+		void PointToImVec2(_In_reads_(uCount) const Aurora::Point* pPoints, _Out_writes_(uCount) ImVec2* pVectors, _In_ size_t uCount) noexcept {
+			static_assert(sizeof(Aurora::Point) == 2 * sizeof(A_I32) && sizeof(ImVec2) == 2 * sizeof(A_FL32), "Points and vectors must be pairs of coordinates.");
+			IntegersToFloats(&pPoints->x, &pVectors->x, uCount * 2);
+		}
+
+		void RGBAToU32(_In_reads_(uCount) const Aurora::RGBA* pColors, _Out_writes_(uCount) ImU32* pPacked, _In_ size_t uCount, _In_ size_t uStride) noexcept {
+#if !defined(IMGUI_USE_BGRA_PACKED_COLOR)
+			ChannelsToU32(&pColors->fR, pPacked, uCount, uStride);
+#else
+			const A_BYTE* lpColors = reinterpret_cast<const A_BYTE*>(pColors);
+			for (size_t i = 0; i < uCount; i++)
+				pPacked[i] = RGBAToU32(*reinterpret_cast<const Aurora::RGBA*>(lpColors + i * uStride));
+#endif // !IMGUI_USE_BGRA_PACKED_COLOR
+		}
+
+		Bounds GetBounds(_In_reads_(uCount) const Aurora::Point* pPoints, _In_ size_t uCount, _In_ A_FL32 fThickness) noexcept {
+			A_I32 nMinX = pPoints[0].x, nMinY = pPoints[0].y, nMaxX = pPoints[0].x, nMaxY = pPoints[0].y;
+			for (size_t i = 1; i < uCount; i++) {
+				if (pPoints[i].x < nMinX) nMinX = pPoints[i].x;
+				if (pPoints[i].y < nMinY) nMinY = pPoints[i].y;
+				if (pPoints[i].x > nMaxX) nMaxX = pPoints[i].x;
+				if (pPoints[i].y > nMaxY) nMaxY = pPoints[i].y;
+			}
+
+			A_FL32 fPadding = fThickness * 0.5F + 1.0F;
+			return {
+				static_cast<A_FL32>(nMinX) - fPadding,
+				static_cast<A_FL32>(nMinY) - fPadding,
+				static_cast<A_FL32>(nMaxX) + fPadding,
+				static_cast<A_FL32>(nMaxY) + fPadding
+			};
+		}
+
+		Bounds GetBounds(_In_ const Aurora::Line& refLine) noexcept { return GetBounds(refLine.szptPoints, 2, refLine.fThickness); }
+
+		Bounds GetBounds(_In_ const Aurora::Rectangle& refRectangle) noexcept {
+			const Aurora::Point szptCorners[2] = { refRectangle.ptTopLeftPoint, refRectangle.ptBottomRightPoint };
+			return GetBounds(szptCorners, 2, refRectangle.fThickness);
+		}
+
+		Bounds GetBounds(_In_ const Aurora::Quad& refQuad) noexcept { return GetBounds(refQuad.szptPoints, 4, refQuad.fThickness); }
+		Bounds GetBounds(_In_ const Aurora::Triangle& refTriangle) noexcept { return GetBounds(refTriangle.szptPoints, 3, refTriangle.fThickness); }
+
+		Bounds GetBounds(_In_ const Aurora::Circle& refCircle) noexcept {
+			A_FL32 fExtent = static_cast<A_FL32>(refCircle.nRadius) + refCircle.fThickness * 0.5F + 1.0F;
+			A_FL32 fX = static_cast<A_FL32>(refCircle.ptCenterPoint.x), fY = static_cast<A_FL32>(refCircle.ptCenterPoint.y);
+			return { fX - fExtent, fY - fExtent, fX + fExtent, fY + fExtent };
+		}
+
+		Bounds GetBounds(_In_ const Aurora::PolyLine<>& refPolyLine) noexcept {
+			// An empty polyline has no extent, so it is culled.
+			if (refPolyLine.szptPoints.size() <= 0) return { 0.0F, 0.0F, -1.0F, -1.0F };
+			return GetBounds(refPolyLine.szptPoints.begin(), refPolyLine.szptPoints.size(), refPolyLine.fThickness);
+		}
+
+		void Intersects(_In_reads_(uCount) const Bounds* pBounds, _In_ size_t uCount, _In_ const Bounds& refRect, _Out_writes_(uCount) bool* pVisible) noexcept {
+			size_t i = 0;
+
+#if defined(ARTEMIS_SIMD_SSE2)
+			// With both maxima negated, the bounds touch the rectangle when each of their lanes is at most the matching lane of vRect.
+			// The comparisons are ordered, so NaN bounds are rejected like they are by the scalar comparison.
+			const __m128 vSigns = _mm_setr_ps(0.0F, 0.0F, -0.0F, -0.0F);
+			const __m128 vRect = _mm_setr_ps(refRect.fMaxX, refRect.fMaxY, -refRect.fMinX, -refRect.fMinY);
+
+#if defined(ARTEMIS_SIMD_AVX2)
+			const __m256 vSigns2 = _mm256_set_m128(vSigns, vSigns);
+			const __m256 vRect2 = _mm256_set_m128(vRect, vRect);
+
+			for (; i + 4 <= uCount; i += 4) {
+				int nLow = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_xor_ps(_mm256_loadu_ps(&pBounds[i].fMinX), vSigns2), vRect2, _CMP_LE_OQ));
+				int nHigh = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_xor_ps(_mm256_loadu_ps(&pBounds[i + 2].fMinX), vSigns2), vRect2, _CMP_LE_OQ));
+
+				pVisible[i] = (nLow & 0xF) == 0xF;
+				pVisible[i + 1] = (nLow >> 4) == 0xF;
+				pVisible[i + 2] = (nHigh & 0xF) == 0xF;
+				pVisible[i + 3] = (nHigh >> 4) == 0xF;
+			}
+#endif // ARTEMIS_SIMD_AVX2
+
+			for (; i < uCount; i++)
+				pVisible[i] = _mm_movemask_ps(_mm_cmple_ps(_mm_xor_ps(_mm_loadu_ps(&pBounds[i].fMinX), vSigns), vRect)) == 0xF;
+#endif // ARTEMIS_SIMD_SSE2
+
+			for (; i < uCount; i++)
+				pVisible[i] = Intersects(pBounds[i], refRect);
+		}
+	}
+
+	namespace {
+		// Unit circles indexed by segment count. Each ring is published once and never changes, so readers need no lock.
+		struct UnitCircleCache {
+			std::atomic<const ImVec2*> szpRings[Helpers::c_nMaxCachedCircleSegments + 1];
 
-			return uRet;
+			~UnitCircleCache() {
+				for (std::atomic<const ImVec2*>& refRing : szpRings)
+					delete[] refRing.load();
+			}
+		} UnitCircles;
+
+		void ComputeUnitCircle(_In_ int nSegments, _Out_writes_(nSegments) ImVec2* pPoints) noexcept {
+			for (int i = 0; i < nSegments; i++) {
+				double dAngle = 2.0 * 3.14159265358979323846 * static_cast<double>(i) / static_cast<double>(nSegments);
+				pPoints[i] = ImVec2(static_cast<float>(std::cos(dAngle)), static_cast<float>(std::sin(dAngle)));
+			}
 		}
 	}
 
+	namespace Helpers {
+		int GetCircleSegmentCount(_In_ A_FL32 fRadius) noexcept {
+			constexpr A_FL32 c_fMaxError = 0.3F;
+			if (!(fRadius > c_fMaxError)) return c_nMinCircleSegments;
+
+			int nSegments = static_cast<int>(std::ceil(3.14159265358979323846F / std::acos(1.0F - c_fMaxError / fRadius)));
+			nSegments += nSegments & 1;
+
+			if (nSegments < c_nMinCircleSegments) return c_nMinCircleSegments;
+			if (nSegments > c_nMaxCachedCircleSegments) return c_nMaxCachedCircleSegments;
+			return nSegments;
+		}
+
+		int GetCircleSegmentCount(_In_ const Aurora::Circle& refCircle) noexcept {
+			if (refCircle.nSegments > c_nMaxCircleSegments) return c_nMaxCircleSegments;
+			return refCircle.nSegments > 2 ? refCircle.nSegments : GetCircleSegmentCount(static_cast<A_FL32>(refCircle.nRadius));
+		}
+
+		_Ret_notnull_ const ImVec2* GetUnitCircle(_In_ int nSegments) {
+			if (nSegments > c_nMaxCachedCircleSegments) {
+				ImVec2* pPoints = FrameArena::Current().Allocate<ImVec2>(nSegments);
+				ComputeUnitCircle(nSegments, pPoints);
+				return pPoints;
+			}
+
+			std::atomic<const ImVec2*>& refRing = UnitCircles.szpRings[nSegments];
+
+			const ImVec2* pRing = refRing.load(std::memory_order_acquire);
+			if (pRing) return pRing;
+
+			// Threads that miss at the same time each compute the ring, and all but the first to publish discard theirs.
+			ImVec2* pPoints = new ImVec2[nSegments];
+			ComputeUnitCircle(nSegments, pPoints);
+
+			if (refRing.compare_exchange_strong(pRing, pPoints, std::memory_order_acq_rel)) return pPoints;
+
+			delete[] pPoints;
+			return pRing;
+		}
+
+		void TransformRing(_In_reads_(nCount) const ImVec2* pRing, _In_ int nCount, _In_ const ImVec2& vCenter, _In_ A_FL32 fRadius, _Out_writes_(nCount) ImVec2* pPoints) noexcept {
+			int i = 0;
+
+#if defined(ARTEMIS_SIMD_AVX2)
+			const __m256 vScale4 = _mm256_set1_ps(fRadius);
+			const __m256 vOffset4 = _mm256_setr_ps(vCenter.x, vCenter.y, vCenter.x, vCenter.y, vCenter.x, vCenter.y, vCenter.x, vCenter.y);
+
+			for (; i + 4 <= nCount; i += 4)
+				_mm256_storeu_ps(&pPoints[i].x, _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&pRing[i].x), vScale4), vOffset4));
+#endif // ARTEMIS_SIMD_AVX2
+
+#if defined(ARTEMIS_SIMD_SSE2)
+			const __m128 vScale = _mm_set1_ps(fRadius);
+			const __m128 vOffset = _mm_setr_ps(vCenter.x, vCenter.y, vCenter.x, vCenter.y);
+
+			for (; i + 2 <= nCount; i += 2)
+				_mm_storeu_ps(&pPoints[i].x, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&pRing[i].x), vScale), vOffset));
+#endif // ARTEMIS_SIMD_SSE2
+
+			for (; i < nCount; i++)
+				pPoints[i] = ImVec2(pRing[i].x * fRadius + vCenter.x, pRing[i].y * fRadius + vCenter.y);
+		}
+
+		A_U32 FormatInteger(_In_ A_I64 nValue, _Out_writes_z_(c_uMaxNumberLength) char* lpBuffer) noexcept {
+			static constexpr char c_szDigitPairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+			// Digits are written backwards two at a time, then copied behind the sign.
+			char szDigits[20];
+			char* pDigit = szDigits + sizeof(szDigits);
+
+			A_U64 uValue = nValue < 0 ? 0 - static_cast<A_U64>(nValue) : static_cast<A_U64>(nValue);
+			while (uValue >= 100) {
+				pDigit -= 2;
+				memcpy(pDigit, &c_szDigitPairs[(uValue % 100) * 2], 2);
+				uValue /= 100;
+			}
+
+			if (uValue >= 10) {
+				pDigit -= 2;
+				memcpy(pDigit, &c_szDigitPairs[uValue * 2], 2);
+			}
+			else *--pDigit = static_cast<char>('0' + uValue);
+
+			A_U32 uLength = 0;
+			if (nValue < 0) lpBuffer[uLength++] = '-';
+
+			A_U32 uDigitCount = static_cast<A_U32>(szDigits + sizeof(szDigits) - pDigit);
+			memcpy(lpBuffer + uLength, pDigit, uDigitCount);
+			uLength += uDigitCount;
+
+			lpBuffer[uLength] = '\0';
+			return uLength;
+		}
+
+		A_U32 FormatFloat(_In_ A_FL64 fValue, _In_range_(0, 9) A_I32 nDecimals, _Out_writes_z_(c_uMaxNumberLength) char* lpBuffer) noexcept {
+			static constexpr A_U64 c_szPowers[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+			if (nDecimals < 0) nDecimals = 0;
+			if (nDecimals > 9) nDecimals = 9;
+
+			// Past 2^53 the scaled value no longer holds every digit. The comparison is also false for NaN.
+			A_FL64 fScaled = std::fabs(fValue) * static_cast<A_FL64>(c_szPowers[nDecimals]);
+			if (!(fScaled < 9007199254740992.0)) {
+				int nLength = snprintf(lpBuffer, c_uMaxNumberLength, "%.*e", nDecimals, fValue);
+				return nLength < 0 ? 0 : (nLength < static_cast<int>(c_uMaxNumberLength) ? static_cast<A_U32>(nLength) : c_uMaxNumberLength - 1);
+			}
+
+			A_U64 uScaled = static_cast<A_U64>(fScaled + 0.5);
+			A_U64 uFraction = uScaled % c_szPowers[nDecimals];
+
+			A_U32 uLength = 0;
+			if (fValue < 0.0 && uScaled) lpBuffer[uLength++] = '-';
+			uLength += FormatInteger(static_cast<A_I64>(uScaled / c_szPowers[nDecimals]), lpBuffer + uLength);
+
+			if (nDecimals) {
+				lpBuffer[uLength++] = '.';
+				for (A_I32 i = nDecimals - 1; i >= 0; i--) {
+					lpBuffer[uLength + i] = static_cast<char>('0' + uFraction % 10);
+					uFraction /= 10;
+				}
+				uLength += nDecimals;
+			}
+
+			lpBuffer[uLength] = '\0';
+			return uLength;
+		}
+	}
+
+	namespace {
+		// The shapes counted by every draw since the last presented frame.
+		std::atomic<A_U64> TotalCulledShapes;
+		std::atomic<A_U64> TotalEmittedShapes;
+
+		DrawStatistics TakeStatistics() noexcept { return { TotalCulledShapes.exchange(0), TotalEmittedShapes.exchange(0) }; }
+
+		// The number of presents a glyph run may go unused before it is evicted.
+		constexpr A_U32 c_uGlyphRunLifetime = 256;
+
+		// FNV-1a over the text, then the font and size.
+		A_U64 HashText(_In_reads_(uLength) const char* lpText, _In_ A_U32 uLength, _In_ const ImFont* pFont, _In_ A_FL32 fSize) noexcept {
+			A_U64 uHash = 14695981039346656037ULL;
+
+			auto Mix = [&uHash](_In_reads_bytes_(uSize) const void* lpData, _In_ size_t uSize) noexcept {
+				for (size_t i = 0; i < uSize; i++) {
+					uHash ^= static_cast<const A_BYTE*>(lpData)[i];
+					uHash *= 1099511628211ULL;
+				}
+			};
+
+			Mix(lpText, uLength);
+			Mix(&pFont, sizeof(pFont));
+			Mix(&fSize, sizeof(fSize));
+			return uHash;
+		}
+	}
+
+	void IDraw::BeginPresent(_In_ ImDrawList* pDrawList) noexcept {
+		this->pDrawList = pDrawList;
+
+		ImVec2 vMin = pDrawList->GetClipRectMin(), vMax = pDrawList->GetClipRectMax();
+		CullRect = { vMin.x, vMin.y, vMax.x, vMax.y };
+
+		if (bClipped) {
+			CullRect.fMinX = ImMax(CullRect.fMinX, ClipRect.fMinX);
+			CullRect.fMinY = ImMax(CullRect.fMinY, ClipRect.fMinY);
+			CullRect.fMaxX = ImMin(CullRect.fMaxX, ClipRect.fMaxX);
+			CullRect.fMaxY = ImMin(CullRect.fMaxY, ClipRect.fMaxY);
+		}
+
+		Statistics = {};
+
+		if (pGlyphRuns && !(++uPresentCount % c_uGlyphRunLifetime)) EvictGlyphRuns();
+	}
+
+	void IDraw::EndPresent() noexcept {
+		if (Statistics.uCulledShapes) TotalCulledShapes.fetch_add(Statistics.uCulledShapes, std::memory_order_relaxed);
+		if (Statistics.uEmittedShapes) TotalEmittedShapes.fetch_add(Statistics.uEmittedShapes, std::memory_order_relaxed);
+	}
+
+	bool IDraw::Cull(_In_ const Bounds& refBounds) noexcept {
+		if (!Helpers::Intersects(refBounds, CullRect)) {
+			Statistics.uCulledShapes++;
+			return true;
+		}
+
+		Statistics.uEmittedShapes++;
+		return false;
+	}
+
+	void IDraw::SetClipRect(_In_ const Bounds& refClipRect) noexcept {
+		ClipRect = refClipRect;
+		bClipped = true;
+	}
+
+	void IDraw::ResetClipRect() noexcept { bClipped = false; }
+
 	void IDraw::AddDraw(_In_ const Aurora::Line& refLine) {
+		if (Cull(Helpers::GetBounds(refLine))) return;
+
 		pDrawList->AddLine(
 			Helpers::PointToImVec2(refLine.szptPoints[0]),
 			Helpers::PointToImVec2(refLine.szptPoints[1]),
@@ -29,6 +336,8 @@ namespace Artemis {
 	}
 
 	void IDraw::AddDraw(_In_ const Aurora::Rectangle& refRectangle) {
+		if (Cull(Helpers::GetBounds(refRectangle))) return;
+
 		if (refRectangle.bFilled) {
 			pDrawList->AddRectFilled(
 				Helpers::PointToImVec2(refRectangle.ptTopLeftPoint),
@@ -51,6 +360,8 @@ namespace Artemis {
 	}
 
 	void IDraw::AddDraw(_In_ const Aurora::Quad& refQuad) {
+		if (Cull(Helpers::GetBounds(refQuad))) return;
+
 		if (refQuad.bFilled) {
 			pDrawList->AddQuadFilled(
 				Helpers::PointToImVec2(refQuad.szptPoints[0]),
@@ -73,6 +384,8 @@ namespace Artemis {
 	}
 
 	void IDraw::AddDraw(_In_ const Aurora::Triangle& refTriangle) {
+		if (Cull(Helpers::GetBounds(refTriangle))) return;
+
 		if (refTriangle.bFilled) {
 			pDrawList->AddTriangleFilled(
 				Helpers::PointToImVec2(refTriangle.szptPoints[0]),
@@ -93,30 +406,28 @@ namespace Artemis {
 	}
 
 	void IDraw::AddDraw(_In_ const Aurora::Circle& refCircle) {
-		if (refCircle.bFilled) {
-			pDrawList->AddCircleFilled(
-				Helpers::PointToImVec2(refCircle.ptCenterPoint),
-				static_cast<float>(refCircle.nRadius),
-				Helpers::RGBAToU32(refCircle.Color),
-				refCircle.nSegments
-			);
-		}
-		else {
-			pDrawList->AddCircle(
-				Helpers::PointToImVec2(refCircle.ptCenterPoint),
-				static_cast<float>(refCircle.nRadius),
-				Helpers::RGBAToU32(refCircle.Color),
-				refCircle.nSegments,
-				refCircle.fThickness
-			);
-		}
+		if (Cull(Helpers::GetBounds(refCircle))) return;
+
+		ImU32 uColor = Helpers::RGBAToU32(refCircle.Color);
+		if (!(uColor & IM_COL32_A_MASK)) return;
+
+		int nSegments = Helpers::GetCircleSegmentCount(refCircle);
+
+		// Outlines are inset by half a pixel like ImDrawList::AddCircle.
+		float fRadius = static_cast<float>(refCircle.nRadius) - (refCircle.bFilled ? 0.0F : 0.5F);
+
+		ImVec2* pPoints = FrameArena::Current().Allocate<ImVec2>(nSegments);
+		Helpers::TransformRing(Helpers::GetUnitCircle(nSegments), nSegments, Helpers::PointToImVec2(refCircle.ptCenterPoint), fRadius, pPoints);
+
+		if (refCircle.bFilled) pDrawList->AddConvexPolyFilled(pPoints, nSegments, uColor);
+		else pDrawList->AddPolyline(pPoints, nSegments, uColor, true, refCircle.fThickness);
 	}
 
 	void IDraw::AddDraw(_In_ const Aurora::PolyLine<>& refPolyLine) {
-		ImVec2* v = new ImVec2[refPolyLine.szptPoints.size()];
+		if (Cull(Helpers::GetBounds(refPolyLine))) return;
 
-		for (int i = 0; i < refPolyLine.szptPoints.size(); i++)
-			v[i] = Helpers::PointToImVec2(refPolyLine.szptPoints[i]);
+		ImVec2* v = FrameArena::Current().Allocate<ImVec2>(refPolyLine.szptPoints.size());
+		Helpers::PointToImVec2(refPolyLine.szptPoints.begin(), v, refPolyLine.szptPoints.size());
 
 		pDrawList->AddPolyline(
 			v,
@@ -125,59 +436,770 @@ namespace Artemis {
 			false,
 			refPolyLine.fThickness
 		);
+	}
+
+	void IDraw::EvictGlyphRuns() noexcept {
+		std::erase_if(*pGlyphRuns, [this](const std::pair<const A_U64, GlyphRun>& refEntry) { return uPresentCount - refEntry.second.uLastUsed > c_uGlyphRunLifetime; });
+	}
+
+	void IDraw::ReplayGlyphRun(_In_ const GlyphRun& refRun, _In_ const ImVec2& vPosition, _In_ ImU32 uColor) {
+		int nVertexCount = refRun.Vertices.Size;
+		int nIndexCount = refRun.Indices.Size;
+		if (!nIndexCount) return;
+
+		pDrawList->PrimReserve(nIndexCount, nVertexCount);
+
+		ImDrawIdx uBaseIndex = static_cast<ImDrawIdx>(pDrawList->_VtxCurrentIdx);
+		for (int i = 0; i < nVertexCount; i++) {
+			const ImDrawVert& refVertex = refRun.Vertices[i];
+			pDrawList->_VtxWritePtr[i] = { ImVec2(refVertex.pos.x + vPosition.x, refVertex.pos.y + vPosition.y), refVertex.uv, uColor };
+		}
+		for (int i = 0; i < nIndexCount; i++)
+			pDrawList->_IdxWritePtr[i] = static_cast<ImDrawIdx>(refRun.Indices[i] + uBaseIndex);
+
+		pDrawList->_VtxWritePtr += nVertexCount;
+		pDrawList->_IdxWritePtr += nIndexCount;
+		pDrawList->_VtxCurrentIdx += nVertexCount;
+	}
+
+	void IDraw::AddText(_In_ const ImVec2& vPosition, _In_reads_(uLength) const char* lpText, _In_ A_U32 uLength, _In_ ImU32 uColor, _In_ A_FL32 fSize) {
+		const ImFont* pFont = pDrawList->_Data->Font;
+		if (!pFont || !(uColor & IM_COL32_A_MASK)) return;
+
+		if (!(fSize > 0.0F)) fSize = pDrawList->_Data->FontSize;
+
+		ImVec2 vSize = pFont->CalcTextSizeA(fSize, FLT_MAX, 0.0F, lpText, lpText + uLength);
+		if (Cull({ vPosition.x, vPosition.y, vPosition.x + vSize.x, vPosition.y + vSize.y })) return;
+
+		pFont->RenderText(pDrawList, fSize, vPosition, uColor, pDrawList->_ClipRectStack.back(), lpText, lpText + uLength);
+	}
+
+	void IDraw::AddDraw(_In_ const Aurora::Text& refText) {
+		ImU32 uColor = Helpers::RGBAToU32(refText.Color);
 
-		delete[] v;
+		const ImFont* pFont = pDrawList->_Data->Font;
+		if (!refText.lpText || !pFont || !(uColor & IM_COL32_A_MASK)) return;
+
+		A_FL32 fSize = refText.fSize > 0.0F ? refText.fSize : pDrawList->_Data->FontSize;
+		A_U32 uLength = static_cast<A_U32>(strlen(refText.lpText));
+		ImVec2 vPosition = Helpers::PointToImVec2(refText.ptPosition);
+
+		if (!pGlyphRuns) pGlyphRuns = std::make_unique<std::unordered_map<A_U64, GlyphRun>>();
+
+		// A hash collision simply replaces the run that was there.
+		GlyphRun& refRun = (*pGlyphRuns)[HashText(refText.lpText, uLength, pFont, fSize)];
+		if (refRun.pFont != pFont || refRun.fSize != fSize || refRun.Text.size() != uLength || memcmp(refRun.Text.data(), refText.lpText, uLength)) {
+			refRun.Text.assign(refText.lpText, uLength);
+			refRun.pFont = pFont;
+			refRun.fSize = fSize;
+			refRun.vSize = pFont->CalcTextSizeA(fSize, FLT_MAX, 0.0F, refText.lpText, refText.lpText + uLength);
+			refRun.bLaidOut = false;
+		}
+
+		refRun.uLastUsed = uPresentCount;
+
+		if (Cull({ vPosition.x, vPosition.y, vPosition.x + refRun.vSize.x, vPosition.y + refRun.vSize.y })) return;
+
+		if (refRun.bLaidOut) {
+			ReplayGlyphRun(refRun, vPosition, uColor);
+			return;
+		}
+
+		int nCommandCount = pDrawList->CmdBuffer.Size;
+		int nVertexStart = pDrawList->VtxBuffer.Size;
+		int nIndexStart = pDrawList->IdxBuffer.Size;
+		unsigned int uBaseIndex = pDrawList->_VtxCurrentIdx;
+
+		// Lay the text out without clipping, so that the run can be replayed anywhere.
+		static const ImVec4 c_vNoClip(-FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX);
+		pFont->RenderText(pDrawList, fSize, vPosition, uColor, c_vNoClip, refText.lpText, refText.lpText + uLength);
+
+		int nVertexCount = pDrawList->VtxBuffer.Size - nVertexStart;
+		int nIndexCount = pDrawList->IdxBuffer.Size - nIndexStart;
+
+		// Like retained draws, the glyphs can only be captured if they went into the current draw command with contiguous indices.
+		if (pDrawList->CmdBuffer.Size != nCommandCount || pDrawList->_VtxCurrentIdx - uBaseIndex != static_cast<unsigned int>(nVertexCount)) return;
+
+		refRun.Vertices.resize(nVertexCount);
+		for (int i = 0; i < nVertexCount; i++) {
+			const ImDrawVert& refVertex = pDrawList->VtxBuffer[nVertexStart + i];
+			refRun.Vertices[i] = { ImVec2(refVertex.pos.x - vPosition.x, refVertex.pos.y - vPosition.y), refVertex.uv, 0 };
+		}
+
+		refRun.Indices.resize(nIndexCount);
+		for (int i = 0; i < nIndexCount; i++)
+			refRun.Indices[i] = static_cast<ImDrawIdx>(pDrawList->IdxBuffer[nIndexStart + i] - uBaseIndex);
+
+		refRun.bLaidOut = true;
 	}
 
-	constexpr IDraw::IDraw(bool bForeground) noexcept : bForeground(bForeground) {}
+	void IDraw::AddNumber(_In_ const Aurora::Point& ptPosition, _In_ A_I64 nValue, _In_ const Aurora::RGBA& Color, _In_ A_FL32 fSize) {
+		char szText[Helpers::c_uMaxNumberLength];
+		A_U32 uLength = Helpers::FormatInteger(nValue, szText);
+		AddText(Helpers::PointToImVec2(ptPosition), szText, uLength, Helpers::RGBAToU32(Color), fSize);
+	}
+
+	void IDraw::AddNumber(_In_ const Aurora::Point& ptPosition, _In_ A_FL64 fValue, _In_range_(0, 9) A_I32 nDecimals, _In_ const Aurora::RGBA& Color, _In_ A_FL32 fSize) {
+		char szText[Helpers::c_uMaxNumberLength];
+		A_U32 uLength = Helpers::FormatFloat(fValue, nDecimals, szText);
+		AddText(Helpers::PointToImVec2(ptPosition), szText, uLength, Helpers::RGBAToU32(Color), fSize);
+	}
+
+	namespace {
+		constexpr int c_nMaxBatchVertices = 0x8000;
+
+		// The outline of a batched shape, in the order ImGui paths it.
+		struct PrimitiveShape {
+			int nPointCount;
+			bool bFilled;
+			bool bClosed;
+			bool bFringed; // Whether the fill gets an anti-aliased fringe. ImDrawList::AddRectFilled draws rectangles without one.
+		};
+
+		constexpr int c_nMaxStoredPoints = 4; // The most points a shape other than a circle has.
+
+		static_assert(Helpers::c_nMaxCircleSegments * 4 <= c_nMaxBatchVertices, "The outline of the largest circle must fit in a batch.");
+
+		// Writes untextured primitives into draw list space reserved with ImDrawList::PrimReserve.
+		class PrimitiveWriter {
+			ImDrawList* pDrawList;
+			ImVec2 vWhitePixel;
+			ImDrawVert* pVertex;
+			ImDrawIdx* pIndex;
+			unsigned int uNextIndex;
+
+		public:
+			PrimitiveWriter(_Inout_ ImDrawList* pDrawList, _In_ int nIndexCount, _In_ int nVertexCount) : pDrawList(pDrawList), vWhitePixel(pDrawList->_Data->TexUvWhitePixel) {
+				pDrawList->PrimReserve(nIndexCount, nVertexCount);
+				pVertex = pDrawList->_VtxWritePtr;
+				pIndex = pDrawList->_IdxWritePtr;
+				uNextIndex = pDrawList->_VtxCurrentIdx;
+			}
+
+			~PrimitiveWriter() {
+				pDrawList->_VtxWritePtr = pVertex;
+				pDrawList->_IdxWritePtr = pIndex;
+				pDrawList->_VtxCurrentIdx = uNextIndex;
+			}
+
+			inline unsigned int Vertex(_In_ const ImVec2& refPosition, _In_ ImU32 uColor) noexcept {
+				pVertex->pos = refPosition;
+				pVertex->uv = vWhitePixel;
+				pVertex->col = uColor;
+				pVertex++;
+				return uNextIndex++;
+			}
+
+			inline void Triangle(_In_ unsigned int uIndex0, _In_ unsigned int uIndex1, _In_ unsigned int uIndex2) noexcept {
+				pIndex[0] = static_cast<ImDrawIdx>(uIndex0);
+				pIndex[1] = static_cast<ImDrawIdx>(uIndex1);
+				pIndex[2] = static_cast<ImDrawIdx>(uIndex2);
+				pIndex += 3;
+			}
+
+			inline void Quad(_In_ const ImVec2& refA, _In_ const ImVec2& refB, _In_ const ImVec2& refC, _In_ const ImVec2& refD, _In_ ImU32 uColor) noexcept {
+				unsigned int uFirst = Vertex(refA, uColor);
+				Vertex(refB, uColor);
+				Vertex(refC, uColor);
+				Vertex(refD, uColor);
+				Triangle(uFirst, uFirst + 1, uFirst + 2);
+				Triangle(uFirst, uFirst + 2, uFirst + 3);
+			}
+
+			inline void Segment(_In_ const ImVec2& refBegin, _In_ const ImVec2& refEnd, _In_ ImU32 uColor, _In_ float fThickness) noexcept {
+				float fDeltaX = refEnd.x - refBegin.x, fDeltaY = refEnd.y - refBegin.y;
+				float fLengthSquared = fDeltaX * fDeltaX + fDeltaY * fDeltaY;
+				float fScale = fLengthSquared > 0.0F ? fThickness * 0.5F / std::sqrt(fLengthSquared) : 0.0F;
+
+				ImVec2 vNormal(-fDeltaY * fScale, fDeltaX * fScale);
+				Quad(
+					ImVec2(refBegin.x + vNormal.x, refBegin.y + vNormal.y),
+					ImVec2(refEnd.x + vNormal.x, refEnd.y + vNormal.y),
+					ImVec2(refEnd.x - vNormal.x, refEnd.y - vNormal.y),
+					ImVec2(refBegin.x - vNormal.x, refBegin.y - vNormal.y),
+					uColor
+				);
+			}
+
+			// The anti-aliased path of ImDrawList::AddConvexPolyFilled: a fan of inner points, each paired with a transparent outer point a pixel further out.
+			inline void FringedFill(_In_reads_(nCount) const ImVec2* pPoints, _In_ int nCount, _In_ ImU32 uColor) noexcept {
+				ImU32 uTransparent = uColor & ~IM_COL32_A_MASK;
+
+				unsigned int uInner = uNextIndex, uOuter = uNextIndex + 1;
+				for (int i = 2; i < nCount; i++)
+					Triangle(uInner, uInner + ((i - 1) << 1), uInner + (i << 1));
+
+				auto GetNormal = [pPoints](_In_ int nFrom, _In_ int nTo) noexcept {
+					float fDeltaX = pPoints[nTo].x - pPoints[nFrom].x, fDeltaY = pPoints[nTo].y - pPoints[nFrom].y;
+					float fLengthSquared = fDeltaX * fDeltaX + fDeltaY * fDeltaY;
+					if (fLengthSquared > 0.0F) {
+						float fInverse = 1.0F / std::sqrt(fLengthSquared);
+						fDeltaX *= fInverse;
+						fDeltaY *= fInverse;
+					}
+					return ImVec2(fDeltaY, -fDeltaX);
+				};
+
+				ImVec2 vPrevious = GetNormal(nCount - 1, 0);
+				for (int i0 = nCount - 1, i1 = 0; i1 < nCount; i0 = i1++) {
+					ImVec2 vNext = GetNormal(i1, i1 + 1 < nCount ? i1 + 1 : 0);
+
+					float fX = (vPrevious.x + vNext.x) * 0.5F, fY = (vPrevious.y + vNext.y) * 0.5F;
+					float fLengthSquared = fX * fX + fY * fY;
+					if (fLengthSquared < 0.5F) fLengthSquared = 0.5F;
+
+					float fScale = 0.5F / fLengthSquared;
+					fX *= fScale;
+					fY *= fScale;
 
-	constexpr bool IDraw::IsForeground() const noexcept { return bForeground; }
+					Vertex(ImVec2(pPoints[i1].x - fX, pPoints[i1].y - fY), uColor);
+					Vertex(ImVec2(pPoints[i1].x + fX, pPoints[i1].y + fY), uTransparent);
+
+					Triangle(uInner + (i1 << 1), uInner + (i0 << 1), uOuter + (i0 << 1));
+					Triangle(uOuter + (i0 << 1), uOuter + (i1 << 1), uInner + (i1 << 1));
+
+					vPrevious = vNext;
+				}
+			}
+
+			inline void Polygon(_In_reads_(refShape.nPointCount) const ImVec2* pPoints, _In_ const PrimitiveShape& refShape, _In_ ImU32 uColor, _In_ float fThickness, _In_ ImDrawListFlags Flags) noexcept {
+				int nCount = refShape.nPointCount;
+
+				if (refShape.bFilled && refShape.bFringed && (Flags & ImDrawListFlags_AntiAliasedFill)) FringedFill(pPoints, nCount, uColor);
+				else if (refShape.bFilled) {
+					unsigned int uFirst = Vertex(pPoints[0], uColor);
+					for (int i = 1; i < nCount; i++)
+						Vertex(pPoints[i], uColor);
+					for (int i = 2; i < nCount; i++)
+						Triangle(uFirst, uFirst + i - 1, uFirst + i);
+				}
+				else {
+					int nSegments = refShape.bClosed ? nCount : nCount - 1;
+					for (int i = 0; i < nSegments; i++)
+						Segment(pPoints[i], pPoints[i + 1 < nCount ? i + 1 : 0], uColor, fThickness);
+				}
+			}
+		};
+
+		inline bool IsVisible(_In_ ImU32 uColor) noexcept { return (uColor & IM_COL32_A_MASK) != 0; }
+
+		// Lines and outlines are left to ImDrawList while it anti-aliases them, since the writer does not reproduce its joins.
+		inline bool IsDrawnDirectly(_In_ const PrimitiveShape& refShape, _In_ ImDrawListFlags Flags) noexcept {
+			return !refShape.bFilled && (Flags & ImDrawListFlags_AntiAliasedLines);
+		}
+
+		void CountPrimitive(_In_ const PrimitiveShape& refShape, _In_ ImDrawListFlags Flags, _Inout_ int& refIndexCount, _Inout_ int& refVertexCount) noexcept {
+			int nCount = refShape.nPointCount;
+
+			if (refShape.bFilled) {
+				refIndexCount += (nCount - 2) * 3;
+				refVertexCount += nCount;
+
+				if (refShape.bFringed && (Flags & ImDrawListFlags_AntiAliasedFill)) {
+					refIndexCount += nCount * 6;
+					refVertexCount += nCount;
+				}
+			}
+			else {
+				int nSegments = refShape.bClosed ? nCount : nCount - 1;
+				refIndexCount += nSegments * 6;
+				refVertexCount += nSegments * 4;
+			}
+		}
+
+		PrimitiveShape GetShape(_In_ const Aurora::Line&) noexcept { return { 2, false, false, false }; }
+
+		_Ret_notnull_ const ImVec2* GetPoints(_In_ const Aurora::Line& refLine, _Out_writes_(c_nMaxStoredPoints) ImVec2* pStorage) noexcept {
+			// Offset by half a pixel like ImDrawList::AddLine.
+			Helpers::PointToImVec2(refLine.szptPoints, pStorage, 2);
+			for (int i = 0; i < 2; i++)
+				pStorage[i] = ImVec2(pStorage[i].x + 0.5F, pStorage[i].y + 0.5F);
+			return pStorage;
+		}
+
+		PrimitiveShape GetShape(_In_ const Aurora::Rectangle& refRectangle) noexcept { return { 4, static_cast<bool>(refRectangle.bFilled), true, false }; }
+
+		_Ret_notnull_ const ImVec2* GetPoints(_In_ const Aurora::Rectangle& refRectangle, _Out_writes_(c_nMaxStoredPoints) ImVec2* pStorage) noexcept {
+			ImVec2 vMin = Helpers::PointToImVec2(refRectangle.ptTopLeftPoint), vMax = Helpers::PointToImVec2(refRectangle.ptBottomRightPoint);
+
+			// Outlines are inset by half a pixel like ImDrawList::AddRect.
+			if (!refRectangle.bFilled) {
+				vMin = ImVec2(vMin.x + 0.5F, vMin.y + 0.5F);
+				vMax = ImVec2(vMax.x - 0.5F, vMax.y - 0.5F);
+			}
+
+			pStorage[0] = vMin;
+			pStorage[1] = ImVec2(vMax.x, vMin.y);
+			pStorage[2] = vMax;
+			pStorage[3] = ImVec2(vMin.x, vMax.y);
+			return pStorage;
+		}
+
+		PrimitiveShape GetShape(_In_ const Aurora::Quad& refQuad) noexcept { return { 4, static_cast<bool>(refQuad.bFilled), true, true }; }
+
+		_Ret_notnull_ const ImVec2* GetPoints(_In_ const Aurora::Quad& refQuad, _Out_writes_(c_nMaxStoredPoints) ImVec2* pStorage) noexcept {
+			Helpers::PointToImVec2(refQuad.szptPoints, pStorage, 4);
+			return pStorage;
+		}
+
+		PrimitiveShape GetShape(_In_ const Aurora::Triangle& refTriangle) noexcept { return { 3, static_cast<bool>(refTriangle.bFilled), true, true }; }
+
+		_Ret_notnull_ const ImVec2* GetPoints(_In_ const Aurora::Triangle& refTriangle, _Out_writes_(c_nMaxStoredPoints) ImVec2* pStorage) noexcept {
+			Helpers::PointToImVec2(refTriangle.szptPoints, pStorage, 3);
+			return pStorage;
+		}
+
+		PrimitiveShape GetShape(_In_ const Aurora::Circle& refCircle) noexcept { return { Helpers::GetCircleSegmentCount(refCircle), static_cast<bool>(refCircle.bFilled), true, true }; }
+
+		_Ret_notnull_ const ImVec2* GetPoints(_In_ const Aurora::Circle& refCircle, _Out_writes_(c_nMaxStoredPoints) ImVec2* pStorage) {
+			int nSegments = Helpers::GetCircleSegmentCount(refCircle);
+
+			// Outlines are inset by half a pixel like ImDrawList::AddCircle.
+			float fRadius = static_cast<float>(refCircle.nRadius) - (refCircle.bFilled ? 0.0F : 0.5F);
+
+			ImVec2* pPoints = FrameArena::Current().Allocate<ImVec2>(nSegments);
+			Helpers::TransformRing(Helpers::GetUnitCircle(nSegments), nSegments, Helpers::PointToImVec2(refCircle.ptCenterPoint), fRadius, pPoints);
+			return pPoints;
+		}
+	}
+
+	// Splits a batch into chunks small enough for 16-bit indices, and reserves and writes each chunk in one go.
+	template<class TShape>
+	void IDraw::SubmitBatch(_In_ std::span<const TShape> Shapes) {
+		if (Shapes.empty()) return;
+
+		FrameArena& refArena = FrameArena::Current();
+
+		ImU32* pColors = refArena.Allocate<ImU32>(Shapes.size());
+		Helpers::RGBAToU32(&Shapes[0].Color, pColors, Shapes.size(), sizeof(TShape));
+
+		// Culled shapes are made transparent, so that they are skipped like any other invisible shape.
+		Bounds* pBounds = refArena.Allocate<Bounds>(Shapes.size());
+		bool* pVisible = refArena.Allocate<bool>(Shapes.size());
+
+		for (size_t i = 0; i < Shapes.size(); i++)
+			pBounds[i] = Helpers::GetBounds(Shapes[i]);
+		Helpers::Intersects(pBounds, Shapes.size(), CullRect, pVisible);
+
+		for (size_t i = 0; i < Shapes.size(); i++) {
+			if (!pVisible[i]) {
+				pColors[i] = 0;
+				Statistics.uCulledShapes++;
+			}
+			else if (IsVisible(pColors[i]))
+				Statistics.uEmittedShapes++;
+		}
+
+		ImDrawListFlags Flags = pDrawList->Flags;
+		ImVec2 szvStorage[c_nMaxStoredPoints];
+
+		size_t uBegin = 0;
+		while (uBegin < Shapes.size()) {
+			int nIndexCount = 0, nVertexCount = 0;
+
+			size_t uEnd = uBegin;
+			for (; uEnd < Shapes.size(); uEnd++) {
+				if (!IsVisible(pColors[uEnd])) continue;
+
+				PrimitiveShape Shape = GetShape(Shapes[uEnd]);
+				if (IsDrawnDirectly(Shape, Flags)) break;
+
+				int nShapeIndexCount = 0, nShapeVertexCount = 0;
+				CountPrimitive(Shape, Flags, nShapeIndexCount, nShapeVertexCount);
+
+				if (nVertexCount + nShapeVertexCount > c_nMaxBatchVertices) break;
+
+				nIndexCount += nShapeIndexCount;
+				nVertexCount += nShapeVertexCount;
+			}
+
+			if (nVertexCount) {
+				PrimitiveWriter Writer(pDrawList, nIndexCount, nVertexCount);
+				for (size_t i = uBegin; i < uEnd; i++) {
+					if (IsVisible(pColors[i])) Writer.Polygon(GetPoints(Shapes[i], szvStorage), GetShape(Shapes[i]), pColors[i], Shapes[i].fThickness, Flags);
+				}
+			}
+
+			for (; uEnd < Shapes.size() && IsVisible(pColors[uEnd]); uEnd++) {
+				PrimitiveShape Shape = GetShape(Shapes[uEnd]);
+				if (!IsDrawnDirectly(Shape, Flags)) break;
+
+				pDrawList->AddPolyline(GetPoints(Shapes[uEnd], szvStorage), Shape.nPointCount, pColors[uEnd], Shape.bClosed, Shapes[uEnd].fThickness);
+			}
+
+			uBegin = uEnd;
+		}
+	}
+
+	void IDraw::AddDraw(_In_ std::span<const Aurora::Line> Lines) { SubmitBatch(Lines); }
+	void IDraw::AddDraw(_In_ std::span<const Aurora::Rectangle> Rectangles) { SubmitBatch(Rectangles); }
+	void IDraw::AddDraw(_In_ std::span<const Aurora::Quad> Quads) { SubmitBatch(Quads); }
+	void IDraw::AddDraw(_In_ std::span<const Aurora::Triangle> Triangles) { SubmitBatch(Triangles); }
+	void IDraw::AddDraw(_In_ std::span<const Aurora::Circle> Circles) { SubmitBatch(Circles); }
 
 	void IDraw::Present(_Inout_ ImDrawList* pDrawList) {
-		this->pDrawList = pDrawList;
+		BeginPresent(pDrawList);
+
+		if (pCache) PresentRetained();
+		else Draw();
+
+		EndPresent();
+	}
+
+	void IDraw::SetRetained(_In_ bool bRetained) {
+		if (!bRetained) pCache.reset();
+		else if (!pCache) pCache = std::make_unique<DrawCache>();
+	}
+
+	void IDraw::Invalidate() noexcept {
+		if (pCache) pCache->bValid = false;
+	}
+
+	void IDraw::PresentRetained() {
+		if (pCache->bValid && pCache->Flags == pDrawList->Flags && pCache->CullRect == CullRect) Replay();
+		else Record();
+	}
+
+	void IDraw::Record() {
+		int nCommandCount = pDrawList->CmdBuffer.Size;
+		int nVertexStart = pDrawList->VtxBuffer.Size;
+		int nIndexStart = pDrawList->IdxBuffer.Size;
+		unsigned int uBaseIndex = pDrawList->_VtxCurrentIdx;
+
 		Draw();
+
+		int nVertexCount = pDrawList->VtxBuffer.Size - nVertexStart;
+		int nIndexCount = pDrawList->IdxBuffer.Size - nIndexStart;
+
+		// The geometry can only be replayed if it went into the current draw command and its indices are contiguous.
+		pCache->bValid = pDrawList->CmdBuffer.Size == nCommandCount && pDrawList->_VtxCurrentIdx - uBaseIndex == static_cast<unsigned int>(nVertexCount);
+		if (!pCache->bValid) return;
+
+		pCache->Flags = pDrawList->Flags;
+		pCache->CullRect = CullRect;
+
+		pCache->Vertices.resize(nVertexCount);
+		if (nVertexCount) memcpy(pCache->Vertices.Data, pDrawList->VtxBuffer.Data + nVertexStart, nVertexCount * sizeof(ImDrawVert));
+
+		pCache->Indices.resize(nIndexCount);
+		for (int i = 0; i < nIndexCount; i++)
+			pCache->Indices[i] = static_cast<ImDrawIdx>(pDrawList->IdxBuffer[nIndexStart + i] - uBaseIndex);
+	}
+
+	void IDraw::Replay() {
+		int nVertexCount = pCache->Vertices.Size;
+		int nIndexCount = pCache->Indices.Size;
+		if (!nIndexCount) return;
+
+		pDrawList->PrimReserve(nIndexCount, nVertexCount);
+
+		ImDrawIdx uBaseIndex = static_cast<ImDrawIdx>(pDrawList->_VtxCurrentIdx);
+		memcpy(pDrawList->_VtxWritePtr, pCache->Vertices.Data, nVertexCount * sizeof(ImDrawVert));
+		for (int i = 0; i < nIndexCount; i++)
+			pDrawList->_IdxWritePtr[i] = static_cast<ImDrawIdx>(pCache->Indices[i] + uBaseIndex);
+
+		pDrawList->_VtxWritePtr += nVertexCount;
+		pDrawList->_IdxWritePtr += nIndexCount;
+		pDrawList->_VtxCurrentIdx += nVertexCount;
+	}
+
+	namespace {
+		// Appends every command of a draw list to another one, keeping their clip rectangles and textures.
+		void AppendDrawList(_Inout_ ImDrawList* pTarget, _In_ const ImDrawList* pSource) {
+			for (const ImDrawCmd& refCommand : pSource->CmdBuffer) {
+				if (refCommand.UserCallback) {
+					pTarget->AddCallback(refCommand.UserCallback, refCommand.UserCallbackData);
+					continue;
+				}
+
+				if (!refCommand.ElemCount) continue;
+
+				const ImDrawIdx* pIndices = pSource->IdxBuffer.Data + refCommand.IdxOffset;
+
+				unsigned int uFirstVertex = 0xFFFFFFFF, uLastVertex = 0;
+				for (unsigned int i = 0; i < refCommand.ElemCount; i++) {
+					if (pIndices[i] < uFirstVertex) uFirstVertex = pIndices[i];
+					if (pIndices[i] > uLastVertex) uLastVertex = pIndices[i];
+				}
+
+				int nIndexCount = static_cast<int>(refCommand.ElemCount);
+				int nVertexCount = static_cast<int>(uLastVertex - uFirstVertex + 1);
+
+				pTarget->PushClipRect(ImVec2(refCommand.ClipRect.x, refCommand.ClipRect.y), ImVec2(refCommand.ClipRect.z, refCommand.ClipRect.w));
+				pTarget->PushTextureID(refCommand.TextureId);
+				pTarget->PrimReserve(nIndexCount, nVertexCount);
+
+				unsigned int uBaseIndex = pTarget->_VtxCurrentIdx;
+				memcpy(pTarget->_VtxWritePtr, pSource->VtxBuffer.Data + refCommand.VtxOffset + uFirstVertex, nVertexCount * sizeof(ImDrawVert));
+				for (int i = 0; i < nIndexCount; i++)
+					pTarget->_IdxWritePtr[i] = static_cast<ImDrawIdx>(pIndices[i] - uFirstVertex + uBaseIndex);
+
+				pTarget->_VtxWritePtr += nVertexCount;
+				pTarget->_IdxWritePtr += nIndexCount;
+				pTarget->_VtxCurrentIdx += nVertexCount;
+
+				pTarget->PopTextureID();
+				pTarget->PopClipRect();
+			}
+		}
+	}
+
+	DrawManager::DrawManager() noexcept : szpRecordings() {}
+
+	DrawManager::~DrawManager() {
+		for (ImDrawList* (&refBuffer)[2] : szpRecordings)
+			for (ImDrawList* pRecording : refBuffer)
+				delete pRecording;
 	}
 
 	void DrawManager::PresentAll(_Inout_ ImDrawList* pForegroundDrawList, _Inout_ ImDrawList* pBackgroundDrawList) {
-		for (IDraw* pDraw : InvocableCollection)
-			if (pDraw)
-				pDraw->Present(pDraw->IsForeground() ? pForegroundDrawList : pBackgroundDrawList);
+		const InvokeContext szPhaseContexts[2] = { { pBackgroundDrawList }, { pForegroundDrawList } };
+		InvokeAll(szPhaseContexts);
 	}
 
-	DrawManagerCollection::DrawManagerCollection() { ZeroMemory(DrawManagerArray, sizeof(DrawManagerArray)); }
+	void DrawManager::Record(_In_range_(0, 1) A_U32 uBuffer, _In_ const ImDrawListSharedData* pSharedData, _In_ ImTextureID TextureId) {
+		// Prepare the lists the same way ImGui::NewFrame prepares its foreground and background lists.
+		for (ImDrawList*& refRecording : szpRecordings[uBuffer]) {
+			if (!refRecording) refRecording = new ImDrawList(pSharedData);
+
+			refRecording->_Data = pSharedData;
+			refRecording->Clear();
+			refRecording->PushTextureID(TextureId);
+			refRecording->PushClipRectFullScreen();
+		}
+
+		PresentAll(szpRecordings[uBuffer][1], szpRecordings[uBuffer][0]);
+		Quiesce();
+	}
 
-	DrawManagerCollection::~DrawManagerCollection() { this->Release(); }
+	void DrawManager::Splice(_In_range_(0, 1) A_U32 uBuffer, _Inout_ ImDrawList* pForegroundDrawList, _Inout_ ImDrawList* pBackgroundDrawList) const {
+		if (szpRecordings[uBuffer][0]) AppendDrawList(pBackgroundDrawList, szpRecordings[uBuffer][0]);
+		if (szpRecordings[uBuffer][1]) AppendDrawList(pForegroundDrawList, szpRecordings[uBuffer][1]);
+	}
 
-	DrawManagerIndex DrawManagerCollection::AddNew() {
+	DrawManagerCollection::DrawManagerCollection() : uLayerCount(0), uFrame(0), bChanged(false), pSharedData(std::make_unique<ImDrawListSharedData>()), LastStatistics() {
+		ZeroMemory(Layers, sizeof(Layers));
+		ZeroMemory(szOrder, sizeof(szOrder));
+		ZeroMemory(RecordingJobs, sizeof(RecordingJobs));
+	}
+
+	DrawManagerCollection::~DrawManagerCollection() {
+		pWorkers.reset();
+		this->Release();
+	}
+
+	void DrawManagerCollection::SortLayers() noexcept {
+		bChanged = true;
+		uLayerCount = 0;
 		for (DrawManagerIndex i = 0; i < MAX_INVOKE; i++)
-			if (!DrawManagerArray[i]) {
-				DrawManagerArray[i] = new DrawManager();
+			if (Layers[i].pManager)
+				szOrder[uLayerCount++] = i;
+
+		std::stable_sort(szOrder, szOrder + uLayerCount, [this](DrawManagerIndex nFirst, DrawManagerIndex nSecond) { return Layers[nFirst].nZOrder < Layers[nSecond].nZOrder; });
+	}
+
+	bool DrawManagerCollection::ShouldUpdate(_In_ const Layer& refLayer, _In_ A_U64 uOnFrame) const noexcept {
+		if (refLayer.nReadyBuffer == INVALID_INDEX || refLayer.bUpdateRequested) return true;
+
+		switch (refLayer.UpdateRate) {
+		case LayerUpdateRate::EveryNthFrame:
+			return uOnFrame - refLayer.uLastUpdate >= refLayer.uFrameInterval;
+		case LayerUpdateRate::OnDemand:
+			return false;
+		default:
+			return true;
+		}
+	}
+
+	DrawManagerIndex DrawManagerCollection::AddNew(_In_opt_z_ const char* lpName, _In_ A_I32 nZOrder) {
+		std::lock_guard<std::mutex> Guard(Lock);
+
+		for (DrawManagerIndex i = 0; i < MAX_INVOKE; i++)
+			if (!Layers[i].pManager) {
+				Layers[i] = { new DrawManager(), "", nZOrder, true, LayerUpdateRate::EveryFrame, 1, 0, false, INVALID_INDEX, INVALID_INDEX };
+				if (lpName) strcpy_s(Layers[i].szName, lpName);
+				SortLayers();
 				return i;
 			}
 		return INVALID_INDEX;
 	}
 
 	void DrawManagerCollection::Release(_In_range_(INVALID_INDEX, MAX_INVOKE) DrawManagerIndex nIndex) {
+		std::lock_guard<std::mutex> Guard(Lock);
+		if (pWorkers) pWorkers->Wait();
+
 		if (nIndex == INVALID_INDEX) {
-			for (DrawManager* pDrawManager : DrawManagerArray)
-				if (pDrawManager)
-					delete pDrawManager;
-			memset(DrawManagerArray, 0, sizeof(DrawManagerArray));
+			for (Layer& refLayer : Layers)
+				if (refLayer.pManager)
+					delete refLayer.pManager;
+			memset(Layers, 0, sizeof(Layers));
 		}
-		else if (DrawManagerArray[nIndex]) {
-			delete DrawManagerArray[nIndex];
-			DrawManagerArray[nIndex] = nullptr;
+		else if (nIndex >= 0 && nIndex < MAX_INVOKE && Layers[nIndex].pManager) {
+			delete Layers[nIndex].pManager;
+			memset(&Layers[nIndex], 0, sizeof(Layer));
 		}
+
+		SortLayers();
 	}
 
 	_Ret_maybenull_ DrawManager* DrawManagerCollection::Get(_In_range_(0, MAX_INVOKE) DrawManagerIndex nIndex) {
-		if (nIndex > 64 || nIndex < 0) return nullptr;
-		return DrawManagerArray[nIndex];
+		if (nIndex >= MAX_INVOKE || nIndex < 0) return nullptr;
+		return Layers[nIndex].pManager;
+	}
+
+	DrawManagerIndex DrawManagerCollection::Find(_In_z_ const char* lpName) {
+		std::lock_guard<std::mutex> Guard(Lock);
+
+		for (DrawManagerIndex i = 0; i < MAX_INVOKE; i++)
+			if (Layers[i].pManager && Layers[i].szName[0] && !strcmp(Layers[i].szName, lpName))
+				return i;
+		return INVALID_INDEX;
+	}
+
+	void DrawManagerCollection::SetZOrder(_In_range_(0, MAX_INVOKE) DrawManagerIndex nIndex, _In_ A_I32 nZOrder) {
+		std::lock_guard<std::mutex> Guard(Lock);
+		if (nIndex >= MAX_INVOKE || nIndex < 0 || !Layers[nIndex].pManager) return;
+
+		Layers[nIndex].nZOrder = nZOrder;
+		SortLayers();
+	}
+
+	void DrawManagerCollection::SetEnabled(_In_range_(0, MAX_INVOKE) DrawManagerIndex nIndex, _In_ bool bEnabled) {
+		std::lock_guard<std::mutex> Guard(Lock);
+		if (nIndex >= MAX_INVOKE || nIndex < 0 || !Layers[nIndex].pManager) return;
+
+		if (Layers[nIndex].bEnabled != bEnabled) bChanged = true;
+		Layers[nIndex].bEnabled = bEnabled;
+	}
+
+	void DrawManagerCollection::SetUpdateRate(_In_range_(0, MAX_INVOKE) DrawManagerIndex nIndex, _In_ LayerUpdateRate UpdateRate, _In_ A_U32 uFrameInterval) {
+		std::lock_guard<std::mutex> Guard(Lock);
+		if (nIndex >= MAX_INVOKE || nIndex < 0 || !Layers[nIndex].pManager) return;
+
+		Layers[nIndex].UpdateRate = UpdateRate;
+		Layers[nIndex].uFrameInterval = uFrameInterval ? uFrameInterval : 1;
+	}
+
+	void DrawManagerCollection::RequestUpdate(_In_range_(0, MAX_INVOKE) DrawManagerIndex nIndex) {
+		std::lock_guard<std::mutex> Guard(Lock);
+		if (nIndex >= MAX_INVOKE || nIndex < 0 || !Layers[nIndex].pManager) return;
+
+		Layers[nIndex].bUpdateRequested = true;
 	}
 
 	void DrawManagerCollection::PresentAll(_Inout_ ImDrawList* pForegroundDrawList, _Inout_ ImDrawList* pBackgroundDrawList) {
-		for (DrawManager* pDrawManager : DrawManagerArray)
-			if (pDrawManager)
-				pDrawManager->PresentAll(pForegroundDrawList, pBackgroundDrawList);
+		std::lock_guard<std::mutex> Guard(Lock);
+		uFrame++;
+		bChanged = false;
+
+		// Wait for the recordings started during the previous frame, which become the ones to splice.
+		if (pWorkers) {
+			pWorkers->Wait();
+
+			for (Layer& refLayer : Layers)
+				if (refLayer.nPendingBuffer != INVALID_INDEX) {
+					refLayer.nReadyBuffer = refLayer.nPendingBuffer;
+					refLayer.nPendingBuffer = INVALID_INDEX;
+				}
+		}
+
+		*pSharedData = *ImGui::GetDrawListSharedData();
+		ImTextureID TextureId = ImGui::GetIO().Fonts->TexID;
+
+		A_U32 uJobCount = 0;
+
+		for (A_U32 i = 0; i < uLayerCount; i++) {
+			Layer& refLayer = Layers[szOrder[i]];
+			if (!refLayer.bEnabled) continue;
+
+			bool bUpdate = ShouldUpdate(refLayer, uFrame);
+			if (bUpdate) {
+				refLayer.uLastUpdate = uFrame;
+				refLayer.bUpdateRequested = false;
+			}
+
+			// A recording always goes into the buffer that is not about to be spliced.
+			A_U32 uBuffer = refLayer.nReadyBuffer == 1 ? 0 : 1;
+
+			if (pWorkers) {
+				if (bUpdate) {
+					RecordingJobs[uJobCount++] = { refLayer.pManager, uBuffer };
+					refLayer.nPendingBuffer = uBuffer;
+				}
+			}
+			else if (refLayer.UpdateRate == LayerUpdateRate::EveryFrame) {
+				refLayer.pManager->PresentAll(pForegroundDrawList, pBackgroundDrawList);
+				refLayer.nReadyBuffer = INVALID_INDEX;
+				continue;
+			}
+			else if (bUpdate) {
+				refLayer.pManager->Record(uBuffer, pSharedData.get(), TextureId);
+				refLayer.nReadyBuffer = uBuffer;
+			}
+
+			if (refLayer.nReadyBuffer != INVALID_INDEX)
+				refLayer.pManager->Splice(refLayer.nReadyBuffer, pForegroundDrawList, pBackgroundDrawList);
+		}
+
+		// Statistics are taken before dispatching, so they cover exactly the draws of this frame in serial mode and of the spliced recordings in parallel mode.
+		LastStatistics = TakeStatistics();
+
+		if (uJobCount) {
+			pWorkers->Dispatch(uJobCount, [this, TextureId](A_U32 uJob) {
+				RecordingJobs[uJob].pManager->Record(RecordingJobs[uJob].uBuffer, pSharedData.get(), TextureId);
+				FrameArena::Current().Reset();
+			});
+		}
+	}
+
+	FrameDemand DrawManagerCollection::IsUpdateDue() {
+		std::lock_guard<std::mutex> Guard(Lock);
+		FrameDemand Demand = bChanged ? FrameDemand::Dirty : FrameDemand::None;
+
+		for (A_U32 i = 0; i < uLayerCount; i++) {
+			const Layer& refLayer = Layers[szOrder[i]];
+			if (!refLayer.bEnabled) continue;
+
+			if (refLayer.UpdateRate == LayerUpdateRate::EveryFrame) return FrameDemand::EveryFrame;
+
+			// A recording in progress is spliced by the next call to PresentAll.
+			if (refLayer.nPendingBuffer != INVALID_INDEX || ShouldUpdate(refLayer, uFrame + 1))
+				Demand = FrameDemand::Dirty;
+		}
+
+		return Demand;
+	}
+
+	void DrawManagerCollection::SetParallelRecording(_In_ A_U32 uWorkerCount) {
+		std::lock_guard<std::mutex> Guard(Lock);
+
+		// Destroying the pool waits for the recordings in progress, so they can be spliced like any other.
+		pWorkers.reset();
+		for (Layer& refLayer : Layers)
+			if (refLayer.nPendingBuffer != INVALID_INDEX) {
+				refLayer.nReadyBuffer = refLayer.nPendingBuffer;
+				refLayer.nPendingBuffer = INVALID_INDEX;
+			}
+
+		if (uWorkerCount) pWorkers = std::make_unique<WorkerPool>(uWorkerCount);
+	}
+
+	DrawStatistics DrawManagerCollection::GetStatistics() const noexcept { return LastStatistics; }
+
+	void DrawManagerCollection::Quiesce() noexcept {
+		std::lock_guard<std::mutex> Guard(Lock);
+
+		// Managers that are being recorded are quiesced by their worker, once it is done with them.
+		for (Layer& refLayer : Layers)
+			if (refLayer.pManager && refLayer.nPendingBuffer == INVALID_INDEX)
+				refLayer.pManager->Quiesce();
+	}
+
+#ifdef ARTEMIS_PROFILE
+	void DrawManagerCollection::QueryTimings(_Inout_ std::vector<TimingReport>& refReports) {
+		for (Layer& refLayer : Layers)
+			if (refLayer.pManager)
+				refLayer.pManager->QueryTimings(refReports);
 	}
+#endif // ARTEMIS_PROFILE
 }
\ No newline at end of file
@@ -1,36 +1,228 @@
 #ifndef __ARTEMIS_DRAW_MANAGER_H__
 #define __ARTEMIS_DRAW_MANAGER_H__
 
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+
 #include <Aurora/Shapes.h>
 #include <ImGui/imgui.h>
 
+#include "Conversions.h"
 #include "Definitions.h"
+#include "FrameThrottle.h"
 #include "Manager.h"
+#include "WorkerPool.h"
 
 namespace Artemis {
+	/// <summary>
+	/// An axis-aligned rectangle in screen space, laid out like an ImGui clip rectangle.
+	/// </summary>
+	struct Bounds {
+		A_FL32 fMinX;
+		A_FL32 fMinY;
+		A_FL32 fMaxX;
+		A_FL32 fMaxY;
+
+		constexpr bool operator==(_In_ const Bounds&) const noexcept = default;
+	};
+
+	struct DrawStatistics {
+		A_U64 uCulledShapes;	// Shapes that were rejected because they lie entirely outside the cull rectangle.
+		A_U64 uEmittedShapes;	// Shapes that were tessellated into a draw list.
+	};
+
 	namespace Helpers {
 		ImVec2 PointToImVec2(_In_ const Aurora::Point& refPoint) noexcept;
-		constexpr ImU32 RGBAToU32(_In_ const Aurora::RGBA& refColor) noexcept;
+
+		constexpr ImU32 RGBAToU32(_In_ const Aurora::RGBA& refColor) noexcept {
+			return IM_COL32(ChannelToU8(refColor.fR), ChannelToU8(refColor.fG), ChannelToU8(refColor.fB), ChannelToU8(refColor.fA));
+		}
+
+		/// <summary>
+		/// Converts an array of points, using SSE2 or AVX2 where the build allows it.
+		/// </summary>
+		void PointToImVec2(_In_reads_(uCount) const Aurora::Point* pPoints, _Out_writes_(uCount) ImVec2* pVectors, _In_ size_t uCount) noexcept;
+
+		/// <summary>
+		/// Converts an array of colors, using SSE2 or AVX2 where the build allows it. The results are identical to RGBAToU32.
+		/// </summary>
+		/// <param name="uStride">- The distance in bytes between two colors, so that colors can be read straight out of an array of shapes.</param>
+		void RGBAToU32(_In_reads_(uCount) const Aurora::RGBA* pColors, _Out_writes_(uCount) ImU32* pPacked, _In_ size_t uCount, _In_ size_t uStride = sizeof(Aurora::RGBA)) noexcept;
+
+		constexpr bool Intersects(_In_ const Bounds& refFirst, _In_ const Bounds& refSecond) noexcept {
+			return refFirst.fMinX <= refSecond.fMaxX && refFirst.fMinY <= refSecond.fMaxY && refFirst.fMaxX >= refSecond.fMinX && refFirst.fMaxY >= refSecond.fMinY;
+		}
+
+		/// <summary>
+		/// Gets the bounds of a set of points, grown by half the line thickness plus a pixel for anti-aliasing.
+		/// </summary>
+		Bounds GetBounds(_In_reads_(uCount) const Aurora::Point* pPoints, _In_ size_t uCount, _In_ A_FL32 fThickness) noexcept;
+
+		Bounds GetBounds(_In_ const Aurora::Line& refLine) noexcept;
+		Bounds GetBounds(_In_ const Aurora::Rectangle& refRectangle) noexcept;
+		Bounds GetBounds(_In_ const Aurora::Quad& refQuad) noexcept;
+		Bounds GetBounds(_In_ const Aurora::Triangle& refTriangle) noexcept;
+		Bounds GetBounds(_In_ const Aurora::Circle& refCircle) noexcept;
+		Bounds GetBounds(_In_ const Aurora::PolyLine<>& refPolyLine) noexcept;
+
+		template<int nPointCount>
+		inline Bounds GetBounds(_In_ const Aurora::PolyLine<nPointCount>& refPolyLine) noexcept { return GetBounds(refPolyLine.szptPoints, nPointCount, refPolyLine.fThickness); }
+
+		/// <summary>
+		/// Tests an array of bounds against a rectangle, using SSE2 or AVX2 where the build allows it. The results are identical to Intersects.
+		/// </summary>
+		void Intersects(_In_reads_(uCount) const Bounds* pBounds, _In_ size_t uCount, _In_ const Bounds& refRect, _Out_writes_(uCount) bool* pVisible) noexcept;
+
+		constexpr int c_nMinCircleSegments = 4;
+		constexpr int c_nMaxCachedCircleSegments = 512;
+		constexpr int c_nMaxCircleSegments = 0x2000; // Keeps the vertices of a batched circle outline within a batch, and so within 16-bit indices.
+
+		/// <summary>
+		/// Picks the smallest even segment count that keeps every segment of a circle within a third of a pixel of the true circle.
+		/// </summary>
+		int GetCircleSegmentCount(_In_ A_FL32 fRadius) noexcept;
+
+		/// <summary>
+		/// Gets the segment count of a circle, at most c_nMaxCircleSegments, or picks one from its radius if it has fewer than three.
+		/// </summary>
+		int GetCircleSegmentCount(_In_ const Aurora::Circle& refCircle) noexcept;
+
+		/// <summary>
+		/// <para>Gets the points of a circle of radius 1 around the origin, starting at angle 0.</para>
+		/// <para>Rings of up to c_nMaxCachedCircleSegments segments are computed once and shared by every thread. Larger ones are computed into the frame arena.</para>
+		/// </summary>
+		_Ret_notnull_ const ImVec2* GetUnitCircle(_In_ int nSegments);
+
+		/// <summary>
+		/// Scales a ring and moves it to vCenter, using SSE2 or AVX2 where the build allows it.
+		/// </summary>
+		void TransformRing(_In_reads_(nCount) const ImVec2* pRing, _In_ int nCount, _In_ const ImVec2& vCenter, _In_ A_FL32 fRadius, _Out_writes_(nCount) ImVec2* pPoints) noexcept;
+
+		constexpr A_U32 c_uMaxNumberLength = 32; // Enough for any A_I64 or any text written by FormatFloat, including the terminator.
+
+		/// <summary>
+		/// Writes a number in decimal without going through snprintf, returning the length of the text.
+		/// </summary>
+		A_U32 FormatInteger(_In_ A_I64 nValue, _Out_writes_z_(c_uMaxNumberLength) char* lpBuffer) noexcept;
+
+		/// <summary>
+		/// <para>Writes a number with a fixed number of decimals, rounded half away from zero, returning the length of the text. Values that round to zero are written without a sign.
+		/// Scaling by the decimals is done in double precision, so the last digit can differ from printf once the result has more than 15 significant digits.</para>
+		/// <para>Values whose digits do not fit in a double, as well as NaN and infinities, go through snprintf in exponent notation.</para>
+		/// </summary>
+		A_U32 FormatFloat(_In_ A_FL64 fValue, _In_range_(0, 9) A_I32 nDecimals, _Out_writes_z_(c_uMaxNumberLength) char* lpBuffer) noexcept;
 	}
 
 	class IDraw {
+		// The geometry recorded by the last call to Draw in retained mode, with indices relative to its first vertex.
+		struct DrawCache {
+			ImVector<ImDrawVert> Vertices;
+			ImVector<ImDrawIdx> Indices;
+			ImDrawListFlags Flags;
+			Bounds CullRect;
+			bool bValid;
+		};
+
 		ImDrawList* pDrawList;
 		bool bForeground;
+		A_I32 nPriority;
+		std::unique_ptr<DrawCache> pCache;
+
+		Bounds ClipRect;
+		bool bClipped;
+		Bounds CullRect;
+		DrawStatistics Statistics; // Counted during one present and added to the frame totals at its end.
+
+		// Text laid out by a previous call to AddDraw, with positions relative to the text position and no color.
+		struct GlyphRun {
+			std::string Text;
+			const ImFont* pFont;
+			A_FL32 fSize;
+			ImVec2 vSize;
+			ImVector<ImDrawVert> Vertices;
+			ImVector<ImDrawIdx> Indices;
+			A_U32 uLastUsed;
+			bool bLaidOut;	// False until the glyphs have been captured, which fails if laying them out had to start a new draw command.
+		};
+
+		std::unique_ptr<std::unordered_map<A_U64, GlyphRun>> pGlyphRuns; // Keyed by the hash of the text, font and size.
+		A_U32 uPresentCount;
+
+		void EvictGlyphRuns() noexcept;
+		void ReplayGlyphRun(_In_ const GlyphRun& refRun, _In_ const ImVec2& vPosition, _In_ ImU32 uColor);
+		void AddText(_In_ const ImVec2& vPosition, _In_reads_(uLength) const char* lpText, _In_ A_U32 uLength, _In_ ImU32 uColor, _In_ A_FL32 fSize);
+
+		void BeginPresent(_In_ ImDrawList* pDrawList) noexcept;
+		void EndPresent() noexcept;
+
+		/// <summary>
+		/// Counts a shape as culled and returns true if its bounds lie outside the cull rectangle, or counts it as emitted otherwise.
+		/// </summary>
+		bool Cull(_In_ const Bounds& refBounds) noexcept;
+
+		template<class TShape>
+		void SubmitBatch(_In_ std::span<const TShape> Shapes);
+
+		void PresentRetained();
+		void Record();
+		void Replay();
 
 	protected:
+		/// <summary>
+		/// <para>Toggles retained mode. In retained mode Draw is only called while the object is invalid, and the geometry it emitted is replayed on every other frame.</para>
+		/// <para>Draws that change the clip rectangle or texture, or that add draw commands of their own, are not cached and keep being drawn every frame.</para>
+		/// </summary>
+		void SetRetained(_In_ bool bRetained);
+
+		/// <summary>
+		/// Discards the cached geometry, so that Draw is called again on the next frame. Call it whenever the input of Draw changes.
+		/// </summary>
+		void Invalidate() noexcept;
+
+		/// <summary>
+		/// <para>Sets a rectangle that shapes must touch to be drawn, on top of the clip rectangle of the draw list.</para>
+		/// <para>Only shapes that lie entirely outside of it are rejected; it does not clip the shapes that are drawn.</para>
+		/// </summary>
+		void SetClipRect(_In_ const Bounds& refClipRect) noexcept;
+		void ResetClipRect() noexcept;
+
 		void AddDraw(_In_ const Aurora::Line& refLine);
 		void AddDraw(_In_ const Aurora::Rectangle& refRectangle);
 		void AddDraw(_In_ const Aurora::Quad& refQuad);
 		void AddDraw(_In_ const Aurora::Triangle& refTriangle);
 		void AddDraw(_In_ const Aurora::Circle& refCircle);
 		void AddDraw(_In_ const Aurora::PolyLine<>& refPolyLine);
+
+		/// <summary>
+		/// Draws text with the current font. The laid-out glyphs are cached by text, font and size, so drawing an unchanged label again only copies its vertices.
+		/// </summary>
+		void AddDraw(_In_ const Aurora::Text& refText);
+
+		/// <summary>
+		/// Draws a number without formatting it through snprintf or caching its glyphs, for labels that change on every frame.
+		/// </summary>
+		void AddNumber(_In_ const Aurora::Point& ptPosition, _In_ A_I64 nValue, _In_ const Aurora::RGBA& Color, _In_ A_FL32 fSize = 0.0F);
+		void AddNumber(_In_ const Aurora::Point& ptPosition, _In_ A_FL64 fValue, _In_range_(0, 9) A_I32 nDecimals, _In_ const Aurora::RGBA& Color, _In_ A_FL32 fSize = 0.0F);
+
+		/// <summary>
+		/// <para>Draws a batch of shapes, in order, reserving draw list space once per up to 32K vertices and writing the vertices directly.</para>
+		/// <para>Filled shapes get the same anti-aliased fringe as ImGui when the draw list has ImDrawListFlags_AntiAliasedFill. Lines and outlines are written as one quad per edge, like ImGui draws them without anti-aliasing,
+		/// so while the draw list has ImDrawListFlags_AntiAliasedLines they are drawn through ImDrawList::AddPolyline instead, in their place in the batch.</para>
+		/// </summary>
+		void AddDraw(_In_ std::span<const Aurora::Line> Lines);
+		void AddDraw(_In_ std::span<const Aurora::Rectangle> Rectangles);
+		void AddDraw(_In_ std::span<const Aurora::Quad> Quads);
+		void AddDraw(_In_ std::span<const Aurora::Triangle> Triangles);
+		void AddDraw(_In_ std::span<const Aurora::Circle> Circles);
 		
 		template<int nPointCount>
 		inline void AddDraw(_In_ const Aurora::PolyLine<nPointCount>& refPolyLine) {
+			if (Cull(Helpers::GetBounds(refPolyLine))) return;
+
 			ImVec2 v[nPointCount];
-			
-			for (int i = 0; i < nPointCount; i++)
-				v[i] = Helpers::PointToImVec2(refPolyLine.szptPoints[i]);
+			Helpers::PointToImVec2(refPolyLine.szptPoints, v, nPointCount);
 
 			pDrawList->AddPolyline(
 				v,
@@ -42,44 +234,173 @@ namespace Artemis {
 		}
 
 	public:
-		constexpr IDraw(_In_ bool bForeground = true) noexcept;
+		// Background draws are phase 0 and foreground draws phase 1, so a draw manager submits every background draw before any foreground draw.
+		struct InvokeContext {
+			ImDrawList* pDrawList;
+		};
 
-		constexpr bool IsForeground() const noexcept;
+		constexpr IDraw(_In_ bool bForeground = true, _In_ A_I32 nPriority = 0) noexcept : pDrawList(nullptr), bForeground(bForeground), nPriority(nPriority), pCache(nullptr), ClipRect(), bClipped(false), CullRect(), Statistics(), pGlyphRuns(nullptr), uPresentCount(0) {}
 
+		constexpr bool IsForeground() const noexcept { return bForeground; }
+		constexpr A_U32 GetPhase() const noexcept { return bForeground ? 1 : 0; }
+		constexpr A_I32 GetPriority() const noexcept { return nPriority; }
+		inline bool IsRetained() const noexcept { return pCache != nullptr; }
+
+		virtual ~IDraw() = default;
+
+		/// <summary>
+		/// Adds the shapes of the draw. With parallel recording enabled this runs on a worker thread, so it may only use the AddDraw overloads, never the ImGui context.
+		/// </summary>
 		virtual void Draw() = 0;
 
 		void Present(_Inout_ ImDrawList* pDrawList);
+
+		template<std::derived_from<IDraw> T>
+		static void InvokeRange(_In_ const InvocableRange<IDraw>& refRange, _In_ const InvokeContext& refContext) {
+			for (A_U32 i = 0; i < refRange.uCount; i++) {
+				T* pDraw = static_cast<T*>(refRange.ppObjects[i]);
+				ARTEMIS_TIME_INVOCATION(refRange, i);
+
+				pDraw->BeginPresent(refContext.pDrawList);
+				if (pDraw->pCache) pDraw->PresentRetained();
+				else pDraw->Draw();
+				pDraw->EndPresent();
+			}
+		}
 	};
 
-	using DrawIndex = int;
+	using DrawHandle = InvocableHandle<IDraw>;
 
 #ifdef _ARTEMIS_EXPORT
-	extern template class Manager<IDraw, DrawIndex>;
+	extern template class Manager<IDraw>;
 #else
-	template class ARTEMIS_IMPORT Manager<IDraw, DrawIndex>;
+	template class ARTEMIS_IMPORT Manager<IDraw>;
 #endif // _ARTEMIS_EXPORT
 
-	class DrawManager : public Manager<IDraw, DrawIndex> {
+	class DrawManager : public Manager<IDraw> {
+		ImDrawList* szpRecordings[2][2]; // Private draw lists indexed by buffer and phase, created on first use.
+
 	public:
+		DrawManager() noexcept;
+		~DrawManager();
+
 		void PresentAll(_Inout_ ImDrawList* pForegroundDrawList, _Inout_ ImDrawList* pBackgroundDrawList);
+
+		/// <summary>
+		/// Invokes every draw into the private draw lists of a buffer and quiesces.
+		/// </summary>
+		void Record(_In_range_(0, 1) A_U32 uBuffer, _In_ const ImDrawListSharedData* pSharedData, _In_ ImTextureID TextureId);
+
+		/// <summary>
+		/// Appends what was recorded into a buffer to the foreground and background draw lists.
+		/// </summary>
+		void Splice(_In_range_(0, 1) A_U32 uBuffer, _Inout_ ImDrawList* pForegroundDrawList, _Inout_ ImDrawList* pBackgroundDrawList) const;
 	};
 
 	using DrawManagerIndex = int;
 
+	enum class LayerUpdateRate : int {
+		EveryFrame = 0,		// The layer is drawn every frame.
+		EveryNthFrame = 1,	// The layer is drawn every uFrameInterval frames, and replays its last drawing in between.
+		OnDemand = 2		// The layer is drawn after each call to RequestUpdate, and replays its last drawing otherwise.
+	};
+
+	/// <summary>
+	/// <para>The draw managers, as named layers presented from the lowest to the highest z-order. Layers with the same z-order are presented in index order.</para>
+	/// <para>A layer that is throttled by its update rate records its draws into private draw lists, and splices them into the real ones on every frame until it is drawn again.</para>
+	/// <para>With parallel recording enabled, each layer records its draws into private draw lists on a worker pool while the previous frame is presented.
+	/// PresentAll then only splices the lists recorded during the previous frame into the real ones, in the same order serial presentation would produce.
+	/// Draws are presented one frame late, and must not use the ImGui context from IDraw::Draw.</para>
+	/// </summary>
 	class DrawManagerCollection {
-		DrawManager* DrawManagerArray[MAX_INVOKE];
+		struct Layer {
+			DrawManager* pManager;
+			char szName[MAX_NAME];	// Empty for a layer without a name.
+			A_I32 nZOrder;
+			bool bEnabled;
+			LayerUpdateRate UpdateRate;
+			A_U32 uFrameInterval;
+			A_U64 uLastUpdate;		// The frame the layer was last drawn on.
+			bool bUpdateRequested;
+			A_I32 nReadyBuffer;		// The buffer that holds the last complete recording, or INVALID_INDEX.
+			A_I32 nPendingBuffer;	// The buffer a worker is recording into, or INVALID_INDEX.
+		};
+
+		struct RecordingJob {
+			DrawManager* pManager;
+			A_U32 uBuffer;
+		};
+
+		Layer Layers[MAX_INVOKE];
+		DrawManagerIndex szOrder[MAX_INVOKE]; // The indices of the live layers, sorted by z-order.
+		A_U32 uLayerCount;
+		A_U64 uFrame;
+		bool bChanged; // Whether layers were added, released, reordered, enabled or disabled since the last call to PresentAll.
+
+		std::mutex Lock;
+		std::unique_ptr<WorkerPool> pWorkers;
+		std::unique_ptr<ImDrawListSharedData> pSharedData; // A copy of the shared data of the ImGui context, taken before every recording.
+		RecordingJob RecordingJobs[MAX_INVOKE];
+		DrawStatistics LastStatistics;
+
+		void SortLayers() noexcept;
+		bool ShouldUpdate(_In_ const Layer& refLayer, _In_ A_U64 uOnFrame) const noexcept;
 
 	public:
 		DrawManagerCollection();
 		~DrawManagerCollection();
 
-		DrawManagerIndex AddNew();
+		/// <summary>
+		/// Adds a layer. Its name is copied, so it may be at most MAX_NAME - 1 characters long.
+		/// </summary>
+		DrawManagerIndex AddNew(_In_opt_z_ const char* lpName = nullptr, _In_ A_I32 nZOrder = 0);
 
 		void Release(_In_range_(INVALID_INDEX, MAX_INVOKE) DrawManagerIndex nIndex = INVALID_INDEX);
 
 		_Ret_maybenull_ DrawManager* Get(_In_range_(0, MAX_INVOKE) DrawManagerIndex nIndex);
 
+		/// <summary>
+		/// Finds a layer by name, returning INVALID_INDEX if there is none.
+		/// </summary>
+		DrawManagerIndex Find(_In_z_ const char* lpName);
+
+		void SetZOrder(_In_range_(0, MAX_INVOKE) DrawManagerIndex nIndex, _In_ A_I32 nZOrder);
+		void SetEnabled(_In_range_(0, MAX_INVOKE) DrawManagerIndex nIndex, _In_ bool bEnabled);
+
+		/// <summary>
+		/// Sets how often a layer is drawn. uFrameInterval is only used by LayerUpdateRate::EveryNthFrame.
+		/// </summary>
+		void SetUpdateRate(_In_range_(0, MAX_INVOKE) DrawManagerIndex nIndex, _In_ LayerUpdateRate UpdateRate, _In_ A_U32 uFrameInterval = 1);
+
+		/// <summary>
+		/// Makes a throttled layer draw again on the next frame.
+		/// </summary>
+		void RequestUpdate(_In_range_(0, MAX_INVOKE) DrawManagerIndex nIndex);
+
 		void PresentAll(_Inout_ ImDrawList* pForegroundDrawList, _Inout_ ImDrawList* pBackgroundDrawList);
+
+		/// <summary>
+		/// Checks whether the next call to PresentAll would present anything different from the last one, so a caller that throttles its frames knows when it can skip it.
+		/// An enabled layer that is drawn every frame demands every frame. Throttled layers count the calls to PresentAll as their frames.
+		/// </summary>
+		FrameDemand IsUpdateDue();
+
+		/// <summary>
+		/// <para>Enables parallel recording on a pool of uWorkerCount threads, or disables it if uWorkerCount is 0.</para>
+		/// <para>It is disabled by default. Only enable it once every registered draw keeps to the rule of IDraw::Draw and never touches the ImGui context.</para>
+		/// </summary>
+		void SetParallelRecording(_In_ A_U32 uWorkerCount);
+
+		/// <summary>
+		/// Gets how many shapes were culled and emitted by every draw manager during the last presented frame.
+		/// </summary>
+		DrawStatistics GetStatistics() const noexcept;
+
+		void Quiesce() noexcept;
+
+#ifdef ARTEMIS_PROFILE
+		void QueryTimings(_Inout_ std::vector<TimingReport>& refReports);
+#endif // ARTEMIS_PROFILE
 	};
 }
 
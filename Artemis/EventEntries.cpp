@@ -4,53 +4,17 @@
 
 #include "GameManager.h"
 
-static Artemis::Engine::GameManager GameManager(Aurora::GetCurrentProcessInfo().GetModule());
-static Artemis::Engine::GameState LastGameState = Artemis::Engine::GameState::MainMenu;
-
-bool EnterMainMenuEventEntry::Condition() {
-	Artemis::Engine::GameState GameState = GameManager.GetGameState();
-	bool bCondition = GameState != LastGameState && GameState == Artemis::Engine::GameState::MainMenu;
-	LastGameState = GameState;
-	return bCondition;
-}
-
-void EnterMainMenuEventEntry::Invoke() {
-	Artemis::Engine::Events::EnterMainMenuEventArgs e;
-	Artemis::Engine::Events::EnterMainMenuEvent.Invoke(this, &e);
-}
-
-bool EnterCustomGameLobbyEventEntry::Condition() {
-	Artemis::Engine::GameState GameState = GameManager.GetGameState();
-	bool bCondition = GameState != LastGameState && GameState == Artemis::Engine::GameState::GamePreLobby;
-	LastGameState = GameState;
-	return bCondition;
-}
-
-void EnterCustomGameLobbyEventEntry::Invoke() {
-	Artemis::Engine::Events::EnterCustomGameLobbyEventArgs e;
-	Artemis::Engine::Events::EnterCustomGameLobbyEvent.Invoke(this, &e);
-}
-
-bool EnterPickPhaseEventEntry::Condition() {
-	Artemis::Engine::GameState GameState = GameManager.GetGameState();
-	bool bCondition = GameState != LastGameState && GameState == Artemis::Engine::GameState::PickPhase;
-	LastGameState = GameState;
-	return bCondition;
+template<class TEventArgs, Aurora::Event<TEventArgs>& refEvent>
+static void InvokeEvent(Artemis::Engine::GameStateDispatcher* pSender) {
+	TEventArgs e;
+	refEvent.Invoke(pSender, &e);
 }
 
-void EnterPickPhaseEventEntry::Invoke() {
-	Artemis::Engine::Events::EnterPickPhaseEventArgs e;
-	Artemis::Engine::Events::EnterPickPhaseEvent.Invoke(this, &e);
-}
-
-bool EnterGameEventEntry::Condition() {
-	Artemis::Engine::GameState GameState = GameManager.GetGameState();
-	bool bCondition = GameState != LastGameState && GameState == Artemis::Engine::GameState::Playing;
-	LastGameState = GameState;
-	return bCondition;
-}
+GameStateEventEntry::GameStateEventEntry() : GameStateDispatcher(Artemis::Engine::GameManager(Aurora::GetCurrentProcessInfo().GetModule())) {
+	using namespace Artemis::Engine;
 
-void EnterGameEventEntry::Invoke() {
-	Artemis::Engine::Events::EnterGameEventArgs e;
-	Artemis::Engine::Events::EnterGameEvent.Invoke(this, &e);
+	Subscribe(GameState::MainMenu, &InvokeEvent<Events::EnterMainMenuEventArgs, Events::EnterMainMenuEvent>);
+	Subscribe(GameState::GamePreLobby, &InvokeEvent<Events::EnterCustomGameLobbyEventArgs, Events::EnterCustomGameLobbyEvent>);
+	Subscribe(GameState::PickPhase, &InvokeEvent<Events::EnterPickPhaseEventArgs, Events::EnterPickPhaseEvent>);
+	Subscribe(GameState::Playing, &InvokeEvent<Events::EnterGameEventArgs, Events::EnterGameEvent>);
 }
\ No newline at end of file
@@ -1,27 +1,8 @@
 #pragma once
 
-#include "EventManager.h"
+#include "GameStateDispatcher.h"
 
-class EnterMainMenuEventEntry : public Artemis::IEventEntry {
+class GameStateEventEntry : public Artemis::Engine::GameStateDispatcher {
 public:
-	virtual bool Condition() final;
-	virtual void Invoke() final;
-};
-
-class EnterCustomGameLobbyEventEntry : public Artemis::IEventEntry {
-public:
-	virtual bool Condition() final;
-	virtual void Invoke() final;
-};
-
-class EnterPickPhaseEventEntry : public Artemis::IEventEntry {
-public:
-	virtual bool Condition() final;
-	virtual void Invoke() final;
-};
-
-class EnterGameEventEntry : public Artemis::IEventEntry {
-public:
-	virtual bool Condition() final;
-	virtual void Invoke() final;
+	GameStateEventEntry();
 };
\ No newline at end of file
@@ -1,10 +1,153 @@
-#include "pch.h"
 #include "EventManager.h"
 
+#include <algorithm>
+
 namespace Artemis {
-	void EventManager::Invoke() {
-		for (IEventEntry* pEntry : InvocableCollection)
-			if (pEntry && pEntry->Condition())
-				pEntry->Invoke();
+	void EventManager::Wheel::Insert(_In_ A_U32 uIndex, _In_ A_U64 uDueTick) { szBuckets[uDueTick % c_uWheelSize].push_back(uIndex); }
+
+	A_U64 EventManager::Wheel::LeastLoaded(_In_ A_U32 uPeriod) const noexcept {
+		A_U64 uBest = uTick + 1;
+
+		for (A_U64 uDueTick = uBest + 1; uDueTick <= uTick + (std::min)(uPeriod, c_uWheelSize); uDueTick++)
+			if (szBuckets[uDueTick % c_uWheelSize].size() < szBuckets[uBest % c_uWheelSize].size())
+				uBest = uDueTick;
+
+		return uBest;
+	}
+
+	void EventManager::Wheel::Clear() noexcept {
+		for (std::vector<A_U32>& refBucket : szBuckets)
+			refBucket.clear();
+	}
+
+	EventManager::EventManager() : uScheduledEpoch(~0ULL), FrameWheel(), TimeWheel(), uFrame(0), Statistics() {}
+
+	void EventManager::Reschedule(_In_ const Snapshot* pSnapshot, _In_ A_U64 uTimeTick) {
+		uScheduledEpoch = pSnapshot->uEpoch;
+
+		EveryFrame.clear();
+		FrameWheel.Clear();
+		TimeWheel.Clear();
+
+		// The time wheel is only advanced by Invoke, so it lags behind the clock until the first frame. New entries are spread from the present on.
+		TimeWheel.uTick = (std::max)(TimeWheel.uTick, uTimeTick);
+
+		RunOf.resize(pSnapshot->Objects.size());
+		for (A_U32 uRun = 0; uRun < pSnapshot->Runs.size(); uRun++)
+			for (A_U32 i = 0; i < pSnapshot->Runs[uRun].uCount; i++)
+				RunOf[pSnapshot->Runs[uRun].uBegin + i] = uRun;
+
+		for (A_U32 i = 0; i < pSnapshot->Objects.size(); i++) {
+			IEventEntry* pEntry = pSnapshot->Objects[i];
+
+			if (pEntry->Schedule.IsEveryFrame()) {
+				EveryFrame.push_back(i);
+				continue;
+			}
+
+			Wheel& refWheel = pEntry->Schedule.Unit == EventScheduleUnit::Frames ? FrameWheel : TimeWheel;
+
+			// Entries that were already scheduled keep their phase, so adding or releasing other entries does not move them.
+			if (!pEntry->bScheduled) {
+				pEntry->uDueTick = refWheel.LeastLoaded(pEntry->Schedule.uPeriod);
+				pEntry->bScheduled = true;
+			}
+			else if (pEntry->uDueTick <= refWheel.uTick)
+				pEntry->uDueTick = refWheel.uTick + 1;
+
+			refWheel.Insert(i, pEntry->uDueTick);
+		}
+
+		Statistics.uRegistered = static_cast<A_U32>(pSnapshot->Objects.size());
 	}
+
+	void EventManager::Advance(_Inout_ Wheel& refWheel, _In_ const Snapshot* pSnapshot, _In_ A_U64 uNow) {
+		if (uNow <= refWheel.uTick) return;
+
+		// Past a full turn, every bucket has been visited, so a long stall costs no more than one turn of the wheel.
+		A_U64 uSteps = (std::min)(uNow - refWheel.uTick, static_cast<A_U64>(c_uWheelSize));
+
+		for (A_U64 uTick = refWheel.uTick + 1; uSteps--; uTick++) {
+			std::vector<A_U32>& refBucket = refWheel.szBuckets[uTick % c_uWheelSize];
+
+			// Entries with periods longer than the wheel share buckets with entries that are due on a later turn.
+			for (size_t i = 0; i < refBucket.size();) {
+				if (pSnapshot->Objects[refBucket[i]]->uDueTick <= uNow) {
+					Due.push_back(refBucket[i]);
+					refBucket[i] = refBucket.back();
+					refBucket.pop_back();
+				}
+				else i++;
+			}
+		}
+
+		refWheel.uTick = uNow;
+	}
+
+	void EventManager::InvokeDue(_In_ const Snapshot* pSnapshot) {
+		std::sort(Due.begin(), Due.end());
+
+		const InvokeContext Context = {};
+
+		// Due entries of the same run are gathered into a range of their own, so they are still invoked through InvokeRange of their type.
+		for (size_t uBegin = 0, uEnd; uBegin < Due.size(); uBegin = uEnd) {
+			A_U32 uRun = RunOf[Due[uBegin]];
+
+			DueObjects.clear();
+#ifdef ARTEMIS_PROFILE
+			DueTimings.clear();
+#endif // ARTEMIS_PROFILE
+
+			for (uEnd = uBegin; uEnd < Due.size() && RunOf[Due[uEnd]] == uRun; uEnd++) {
+				DueObjects.push_back(pSnapshot->Objects[Due[uEnd]]);
+#ifdef ARTEMIS_PROFILE
+				DueTimings.push_back(pSnapshot->Timings[Due[uEnd]]);
+#endif // ARTEMIS_PROFILE
+			}
+
+			Range InvocationRange;
+			InvocationRange.ppObjects = DueObjects.data();
+#ifdef ARTEMIS_PROFILE
+			InvocationRange.ppTimings = DueTimings.data();
+#endif // ARTEMIS_PROFILE
+			InvocationRange.uCount = static_cast<A_U32>(DueObjects.size());
+
+			pSnapshot->Runs[uRun].pfnInvoke(InvocationRange, Context);
+		}
+	}
+
+	void EventManager::Invoke() { Invoke(static_cast<A_U64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count())); }
+
+	void EventManager::Invoke(_In_ A_U64 uNow) {
+		// The time wheel counts milliseconds.
+		A_U64 uTimeTick = uNow / 1000000;
+
+		const Snapshot* pSnapshot = AcquireSnapshot();
+		if (pSnapshot->uEpoch != uScheduledEpoch)
+			Reschedule(pSnapshot, uTimeTick);
+
+		uFrame++;
+
+		Due.assign(EveryFrame.begin(), EveryFrame.end());
+		Advance(FrameWheel, pSnapshot, uFrame);
+		Advance(TimeWheel, pSnapshot, uTimeTick);
+
+		// Put the entries that came off the wheels back in at their next due tick. Periods that were missed are skipped rather than made up for.
+		for (size_t i = EveryFrame.size(); i < Due.size(); i++) {
+			IEventEntry* pEntry = pSnapshot->Objects[Due[i]];
+			Wheel& refWheel = pEntry->Schedule.Unit == EventScheduleUnit::Frames ? FrameWheel : TimeWheel;
+			A_U64 uPeriod = pEntry->Schedule.uPeriod;
+
+			pEntry->uDueTick += ((refWheel.uTick - pEntry->uDueTick) / uPeriod + 1) * uPeriod;
+			refWheel.Insert(Due[i], pEntry->uDueTick);
+		}
+
+		Statistics.uEvaluated = static_cast<A_U32>(Due.size());
+		if (Statistics.uEvaluated > Statistics.uMaxEvaluated)
+			Statistics.uMaxEvaluated = Statistics.uEvaluated;
+
+		InvokeDue(pSnapshot);
+	}
+
+	EventSchedulerStatistics EventManager::GetStatistics() const noexcept { return Statistics; }
 }
\ No newline at end of file
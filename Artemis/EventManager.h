@@ -1,27 +1,139 @@
 #ifndef __ARTEMIS_EVENT_MANAGER_H__
 #define __ARTEMIS_EVENT_MANAGER_H__
 
+#include <chrono>
+#include <vector>
+
 #include "Definitions.h"
 #include "Manager.h"
 
 namespace Artemis {
+	enum class EventScheduleUnit : int {
+		Frames,			// The period is a number of frames.
+		Milliseconds	// The period is a number of milliseconds.
+	};
+
+	/// <summary>
+	/// How often the event manager evaluates the condition of an event entry.
+	/// </summary>
+	struct EventSchedule {
+		EventScheduleUnit Unit;
+		A_U32 uPeriod;
+
+		constexpr EventSchedule(_In_ EventScheduleUnit Unit = EventScheduleUnit::Frames, _In_ A_U32 uPeriod = 1) noexcept : Unit(Unit), uPeriod(uPeriod ? uPeriod : 1) {}
+
+		static constexpr EventSchedule EveryFrame() noexcept { return EventSchedule(); }
+		static constexpr EventSchedule EveryNthFrame(_In_ A_U32 uFrames) noexcept { return EventSchedule(EventScheduleUnit::Frames, uFrames); }
+		static constexpr EventSchedule Every(_In_ std::chrono::milliseconds Interval) noexcept { return EventSchedule(EventScheduleUnit::Milliseconds, static_cast<A_U32>(Interval.count())); }
+
+		constexpr bool IsEveryFrame() const noexcept { return Unit == EventScheduleUnit::Frames && uPeriod == 1; }
+	};
+
 	class IEventEntry {
+		friend class EventManager;
+
+		A_I32 nPriority;
+		EventSchedule Schedule;
+
+		// Owned by the event manager, which only touches them on the invoking thread.
+		A_U64 uDueTick;
+		bool bScheduled;
+
 	public:
+		struct InvokeContext {};
+
+		constexpr IEventEntry(_In_ A_I32 nPriority = 0, _In_ EventSchedule Schedule = EventSchedule::EveryFrame()) noexcept : nPriority(nPriority), Schedule(Schedule), uDueTick(0), bScheduled(false) {}
+
+		constexpr A_I32 GetPriority() const noexcept { return nPriority; }
+		constexpr EventSchedule GetSchedule() const noexcept { return Schedule; }
+
+		virtual ~IEventEntry() = default;
+
 		virtual bool Condition() = 0;
 		virtual void Invoke() = 0;
+
+		template<std::derived_from<IEventEntry> T>
+		static void InvokeRange(_In_ const InvocableRange<IEventEntry>& refRange, _In_ const InvokeContext&) {
+			for (A_U32 i = 0; i < refRange.uCount; i++) {
+				T* pEntry = static_cast<T*>(refRange.ppObjects[i]);
+				ARTEMIS_TIME_INVOCATION(refRange, i);
+
+				if (pEntry->Condition())
+					pEntry->Invoke();
+			}
+		}
 	};
 
-	using EventEntryIndex = int;
+	using EventEntryHandle = InvocableHandle<IEventEntry>;
 
 #ifdef _ARTEMIS_EXPORT
-	extern template class Manager<IEventEntry, EventEntryIndex>;
+	extern template class Manager<IEventEntry>;
 #else
-	template class ARTEMIS_IMPORT Manager<IEventEntry, EventEntryIndex>;
+	template class ARTEMIS_IMPORT Manager<IEventEntry>;
 #endif // _ARTEMIS_EXPORT
 
-	class ARTEMIS_API EventManager : public Manager<IEventEntry, EventEntryIndex> {
+	struct EventSchedulerStatistics {
+		A_U32 uRegistered;
+		A_U32 uEvaluated;	// The entries that were due in the last frame.
+		A_U32 uMaxEvaluated;
+	};
+
+	/// <summary>
+	/// <para>Evaluates the event entries that are due each frame, rather than every entry every frame.</para>
+	/// <para>Entries that poll every frame are kept in a list of their own. The others wait in one of two timer wheels, counted in frames or in milliseconds, and each frame only the buckets the clocks moved past are visited.</para>
+	/// <para>A new entry is placed in the least loaded bucket within its first period, so entries with equal periods are spread over frames instead of all falling due on the same one.</para>
+	/// <para>Due entries are invoked in the same order as the registry, by priority and then in runs of their concrete type.</para>
+	/// </summary>
+	class ARTEMIS_API EventManager : public Manager<IEventEntry> {
 	public:
+		static constexpr A_U32 c_uWheelSize = 256; // The number of buckets in each wheel. Periods past it wrap around, and entries only run once their due tick is reached.
+
+	private:
+		struct Wheel {
+			std::vector<A_U32> szBuckets[c_uWheelSize]; // The snapshot indices of the entries in each bucket.
+			A_U64 uTick; // The last tick that was advanced past.
+
+			void Insert(_In_ A_U32 uIndex, _In_ A_U64 uDueTick);
+			A_U64 LeastLoaded(_In_ A_U32 uPeriod) const noexcept;
+			void Clear() noexcept;
+		};
+
+		A_U64 uScheduledEpoch; // The epoch of the snapshot the schedule was built from.
+		std::vector<A_U32> RunOf; // The index of the run of each object in the scheduled snapshot.
+		std::vector<A_U32> EveryFrame;
+		Wheel FrameWheel;
+		Wheel TimeWheel;
+
+		A_U64 uFrame;
+
+		// Reused every frame, so invoking does not allocate once they have grown.
+		std::vector<A_U32> Due;
+		std::vector<IEventEntry*> DueObjects;
+#ifdef ARTEMIS_PROFILE
+		std::vector<InvocableTimings*> DueTimings;
+#endif // ARTEMIS_PROFILE
+
+		EventSchedulerStatistics Statistics;
+
+		void Reschedule(_In_ const Snapshot* pSnapshot, _In_ A_U64 uTimeTick);
+		void Advance(_Inout_ Wheel& refWheel, _In_ const Snapshot* pSnapshot, _In_ A_U64 uNow);
+		void InvokeDue(_In_ const Snapshot* pSnapshot);
+
+	public:
+		EventManager();
+
+		/// <summary>
+		/// Evaluates the entries that are due this frame. Only to be called from the invoking thread, once per frame.
+		/// </summary>
 		void Invoke();
+
+		/// <summary>
+		/// Evaluates the entries that are due this frame, at a time the caller took. Only to be called from the invoking thread, once per frame.
+		/// </summary>
+		/// <param name="uNow">- The current time, in nanoseconds of the steady clock.</param>
+		void Invoke(_In_ A_U64 uNow);
+
+		EventSchedulerStatistics GetStatistics() const noexcept;
 	};
 }
 
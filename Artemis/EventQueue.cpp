@@ -0,0 +1,260 @@
+#include "EventQueue.h"
+
+#include <bit>
+#include <cstdint>
+
+namespace Artemis {
+	EventQueue::EventQueue(_In_ A_U32 uCapacity, _In_ BackpressurePolicy Policy) :
+		uMask(std::bit_ceil(uCapacity > 2 ? uCapacity : 2) - 1),
+		Policy(Policy),
+		uEnqueuePosition(0),
+		uDequeuePosition(0),
+		uSignal(0),
+		bSleeping(false),
+		bStopping(false),
+		bRunning(false),
+		uNextStamp(0),
+		uEnqueued(0),
+		uDelivered(0),
+		uDropped(0),
+		uCoalesced(0),
+		uMaxDepth(0)
+	{
+		pCells = std::make_unique<Cell[]>(uMask + 1);
+		for (A_U64 i = 0; i <= uMask; i++)
+			pCells[i].uSequence.store(i, std::memory_order_relaxed);
+
+		for (CoalesceSlot& refSlot : szCoalesceSlots) {
+			refSlot.lpEvent.store(nullptr, std::memory_order_relaxed);
+			refSlot.uLatestStamp.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	EventQueue::~EventQueue() { Stop(); }
+
+	A_U32 EventQueue::GetCoalesceSlot(_In_ A_LPCVOID lpEvent) noexcept {
+		A_U32 uHash = static_cast<A_U32>((static_cast<A_U64>(reinterpret_cast<uintptr_t>(lpEvent)) >> 4) * 0x9E3779B97F4A7C15ULL >> 32);
+
+		// Slots are only ever claimed, never freed, so a probe can stop at the first empty slot it fails to claim for another event.
+		for (A_U32 i = 0; i < c_uCoalesceSlots; i++) {
+			CoalesceSlot& refSlot = szCoalesceSlots[(uHash + i) % c_uCoalesceSlots];
+
+			A_LPCVOID lpClaimed = refSlot.lpEvent.load(std::memory_order_acquire);
+			if (!lpClaimed && refSlot.lpEvent.compare_exchange_strong(lpClaimed, lpEvent, std::memory_order_acq_rel))
+				return (uHash + i) % c_uCoalesceSlots;
+			if (lpClaimed == lpEvent)
+				return (uHash + i) % c_uCoalesceSlots;
+		}
+
+		return INVALID_SLOT;
+	}
+
+	bool EventQueue::IsSuperseded(_In_ const Item& refItem) const noexcept {
+		return refItem.uCoalesceSlot != INVALID_SLOT && refItem.uStamp < szCoalesceSlots[refItem.uCoalesceSlot].uLatestStamp.load(std::memory_order_acquire);
+	}
+
+	bool EventQueue::Push(_Inout_ Item& refItem) {
+		refItem.uCoalesceSlot = INVALID_SLOT;
+		refItem.uStamp = 0;
+
+		if (Policy == BackpressurePolicy::Coalesce) {
+			refItem.uCoalesceSlot = GetCoalesceSlot(refItem.lpEvent);
+
+			if (refItem.uCoalesceSlot != INVALID_SLOT) {
+				refItem.uStamp = uNextStamp.fetch_add(1, std::memory_order_relaxed) + 1;
+
+				// Producers of the same event may race, so only ever raise the latest stamp.
+				std::atomic<A_U64>& refLatest = szCoalesceSlots[refItem.uCoalesceSlot].uLatestStamp;
+				for (A_U64 uLatest = refLatest.load(std::memory_order_relaxed); uLatest < refItem.uStamp && !refLatest.compare_exchange_weak(uLatest, refItem.uStamp, std::memory_order_acq_rel););
+			}
+		}
+
+		while (true) {
+			A_U64 uPosition = uEnqueuePosition.load(std::memory_order_relaxed);
+
+			while (true) {
+				Cell& refCell = pCells[uPosition & uMask];
+				A_I64 nDifference = static_cast<A_I64>(refCell.uSequence.load(std::memory_order_acquire) - uPosition);
+
+				if (nDifference == 0) {
+					if (uEnqueuePosition.compare_exchange_weak(uPosition, uPosition + 1)) {
+						refCell.Value = refItem;
+						refCell.uSequence.store(uPosition + 1, std::memory_order_release);
+
+						uEnqueued.fetch_add(1, std::memory_order_relaxed);
+
+						// Consumers may already have moved past this item, which would make the depth negative.
+						A_I64 nDepth = static_cast<A_I64>(uPosition + 1 - uDequeuePosition.load(std::memory_order_relaxed));
+						A_U32 uDepth = nDepth > 0 ? static_cast<A_U32>(nDepth) : 0;
+						for (A_U32 uMax = uMaxDepth.load(std::memory_order_relaxed); uDepth > uMax && !uMaxDepth.compare_exchange_weak(uMax, uDepth, std::memory_order_relaxed););
+
+						if (bSleeping.load()) {
+							uSignal.fetch_add(1);
+							uSignal.notify_one();
+						}
+						return true;
+					}
+				}
+				else if (nDifference < 0) break; // The queue is full.
+				else uPosition = uEnqueuePosition.load(std::memory_order_relaxed);
+			}
+
+			// Blocking on a queue that nobody drains would never return, so it drops like the other policies instead.
+			if (Policy == BackpressurePolicy::Block && bRunning.load(std::memory_order_acquire)) {
+				std::this_thread::yield();
+				continue;
+			}
+
+			Item Evicted;
+			if (Pop(Evicted)) {
+				if (IsSuperseded(Evicted)) uCoalesced.fetch_add(1, std::memory_order_relaxed);
+				else uDropped.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	bool EventQueue::Pop(_Out_ Item& refItem) noexcept {
+		A_U64 uPosition = uDequeuePosition.load(std::memory_order_relaxed);
+
+		while (true) {
+			Cell& refCell = pCells[uPosition & uMask];
+			A_I64 nDifference = static_cast<A_I64>(refCell.uSequence.load(std::memory_order_acquire) - (uPosition + 1));
+
+			if (nDifference == 0) {
+				if (uDequeuePosition.compare_exchange_weak(uPosition, uPosition + 1)) {
+					refItem = refCell.Value;
+					refCell.uSequence.store(uPosition + uMask + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (nDifference < 0) return false; // The queue is empty, or the next item is still being written.
+			else uPosition = uDequeuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	void EventQueue::DispatcherMain() {
+		std::vector<Item> Batch;
+		Batch.reserve(c_uBatchSize);
+
+		while (true) {
+			Batch.clear();
+
+			Item Next;
+			while (Batch.size() < c_uBatchSize && Pop(Next)) {
+				if (IsSuperseded(Next)) uCoalesced.fetch_add(1, std::memory_order_relaxed);
+				else Batch.push_back(Next);
+			}
+
+			if (!Batch.empty()) {
+				Deliver(Batch);
+				continue;
+			}
+
+			if (uDequeuePosition.load() != uEnqueuePosition.load()) {
+				// An item has been claimed but not written yet.
+				std::this_thread::yield();
+				continue;
+			}
+
+			if (bStopping.load()) return;
+
+			// Announce the sleep before checking for items one last time, so a producer either sees the announcement or its item is seen here.
+			A_U32 uObserved = uSignal.load();
+			bSleeping.store(true);
+			if (uDequeuePosition.load() == uEnqueuePosition.load() && !bStopping.load())
+				uSignal.wait(uObserved);
+			bSleeping.store(false);
+		}
+	}
+
+	void EventQueue::Deliver(_In_ const std::vector<Item>& refBatch) {
+		A_U32 uAnyThread = 0;
+		A_U32 uRenderThread = 0;
+		for (const Item& refItem : refBatch) {
+			uAnyThread += refItem.bAnyThread;
+			uRenderThread += refItem.bRenderThread;
+		}
+
+		// Invocations with render-thread handlers are counted by DispatchDeferred once those have been called, or as dropped below.
+		A_U32 uAnyThreadOnly = static_cast<A_U32>(refBatch.size()) - uRenderThread;
+
+		if (uRenderThread) {
+			std::lock_guard<std::mutex> Guard(DeferredLock);
+
+			for (const Item& refItem : refBatch) {
+				if (!refItem.bRenderThread) continue;
+
+				// The render thread is not keeping up, so the backlog is bounded by the capacity of the queue like the queue itself.
+				if (Deferred.size() > uMask) {
+					uDropped.fetch_add(1, std::memory_order_relaxed);
+					continue;
+				}
+				Deferred.push_back(refItem);
+			}
+		}
+
+		if (pWorkers && uAnyThread > 1) {
+			pWorkers->Dispatch(static_cast<A_U32>(refBatch.size()), [&](A_U32 uItem) {
+				if (refBatch[uItem].bAnyThread)
+					refBatch[uItem].pfnDispatch(refBatch[uItem], Aurora::EventHandlerAffinity::AnyThread);
+			});
+			pWorkers->Wait();
+		}
+		else if (uAnyThread) {
+			for (const Item& refItem : refBatch)
+				if (refItem.bAnyThread)
+					refItem.pfnDispatch(refItem, Aurora::EventHandlerAffinity::AnyThread);
+		}
+
+		uDelivered.fetch_add(uAnyThreadOnly, std::memory_order_relaxed);
+	}
+
+	void EventQueue::Start(_In_ A_U32 uWorkerCount) {
+		if (DispatchThread.joinable()) return;
+
+		if (uWorkerCount) pWorkers = std::make_unique<WorkerPool>(uWorkerCount);
+
+		bStopping.store(false);
+		bRunning.store(true, std::memory_order_release);
+		DispatchThread = std::thread(&EventQueue::DispatcherMain, this);
+	}
+
+	void EventQueue::Stop() {
+		if (!DispatchThread.joinable()) return;
+
+		bStopping.store(true);
+		uSignal.fetch_add(1);
+		uSignal.notify_one();
+
+		DispatchThread.join();
+		bRunning.store(false, std::memory_order_release);
+
+		pWorkers.reset();
+	}
+
+	void EventQueue::DispatchDeferred() {
+		{
+			std::lock_guard<std::mutex> Guard(DeferredLock);
+			if (Deferred.empty()) return;
+			Deferred.swap(Dispatching);
+		}
+
+		for (const Item& refItem : Dispatching)
+			refItem.pfnDispatch(refItem, Aurora::EventHandlerAffinity::RenderThread);
+
+		uDelivered.fetch_add(Dispatching.size(), std::memory_order_relaxed);
+		Dispatching.clear();
+	}
+
+	EventQueueStatistics EventQueue::GetStatistics() const noexcept {
+		EventQueueStatistics Statistics;
+		Statistics.uEnqueued = uEnqueued.load(std::memory_order_relaxed);
+		Statistics.uDelivered = uDelivered.load(std::memory_order_relaxed);
+		Statistics.uDropped = uDropped.load(std::memory_order_relaxed);
+		Statistics.uCoalesced = uCoalesced.load(std::memory_order_relaxed);
+		A_U64 uDequeued = uDequeuePosition.load(std::memory_order_relaxed);
+		Statistics.uDepth = static_cast<A_U32>(uEnqueuePosition.load(std::memory_order_relaxed) - uDequeued);
+		Statistics.uMaxDepth = uMaxDepth.load(std::memory_order_relaxed);
+		return Statistics;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+#ifndef __ARTEMIS_EVENT_QUEUE_H__
+#define __ARTEMIS_EVENT_QUEUE_H__
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <Aurora/Definitions.h>
+#include <Aurora/Events.h>
+
+#include "Definitions.h"
+#include "WorkerPool.h"
+
+namespace Artemis {
+	enum class BackpressurePolicy : int {
+		DropOldest,	// The oldest waiting event is dropped to make room for the new one.
+		Coalesce,	// Only the newest waiting invocation of each event is delivered. The oldest waiting event is dropped to make room when the queue is still full.
+		Block		// The invoking thread waits for room.
+	};
+
+	struct EventQueueStatistics {
+		A_U64 uEnqueued;
+		A_U64 uDelivered;	// The events whose handlers have all been called, counting the render-thread handlers once DispatchDeferred has called them.
+		A_U64 uDropped;		// The events that were lost to a full queue, or to a render thread that fell behind on its deferred handlers.
+		A_U64 uCoalesced;	// The events that were skipped because a newer invocation of the same event was waiting.
+		A_U32 uDepth;
+		A_U32 uMaxDepth;
+	};
+
+	/// <summary>
+	/// <para>A bounded queue of asynchronous event invocations, drained by a dispatch thread of its own.</para>
+	/// <para>Enqueue copies the event args into the queue without locking, so invoking an event only costs the copy. The handlers with the any-thread affinity are called on the dispatch thread, or spread over the workers when there are any. Handlers with the render-thread affinity are handed back to the render thread, which calls them in DispatchDeferred.</para>
+	/// <para>The event and the sender must outlive every invocation of them that is still queued. Event args must be trivially copyable, no larger than c_uMaxArgsSize and aligned to at most 16 bytes.</para>
+	/// </summary>
+	class ARTEMIS_API EventQueue {
+	public:
+		static constexpr A_U32 c_uMaxArgsSize = 64;
+		static constexpr A_U32 c_uBatchSize = 64;
+		static constexpr A_U32 c_uCoalesceSlots = 64; // The number of distinct events that are coalesced. Events past it are always delivered.
+
+	private:
+		struct Item;
+
+		using Dispatcher = void(*)(_In_ const Item& refItem, _In_ Aurora::EventHandlerAffinity Affinity);
+
+		struct Item {
+			A_LPCVOID lpEvent;
+			A_LPVOID lpSender;
+			Dispatcher pfnDispatch;
+			A_U64 uStamp;
+			A_U32 uCoalesceSlot;
+			bool bHasArgs;
+			bool bAnyThread;
+			bool bRenderThread;
+			alignas(16) A_BYTE szArgs[c_uMaxArgsSize];
+		};
+
+		struct Cell {
+			std::atomic<A_U64> uSequence;
+			Item Value;
+		};
+
+		struct CoalesceSlot {
+			std::atomic<A_LPCVOID> lpEvent;
+			std::atomic<A_U64> uLatestStamp;
+		};
+
+		template<class TArgs>
+		static void Dispatch(_In_ const Item& refItem, _In_ Aurora::EventHandlerAffinity Affinity) {
+			const Aurora::Event<TArgs>* pEvent = static_cast<const Aurora::Event<TArgs>*>(refItem.lpEvent);
+
+			if constexpr (std::is_same_v<TArgs, Aurora::NullClass_t>)
+				pEvent->Invoke(refItem.lpSender, Affinity);
+			else
+				pEvent->Invoke(refItem.lpSender, refItem.bHasArgs ? std::launder(reinterpret_cast<const TArgs*>(refItem.szArgs)) : nullptr, Affinity);
+		}
+
+		std::unique_ptr<Cell[]> pCells;
+		A_U64 uMask;
+		BackpressurePolicy Policy;
+
+		alignas(64) std::atomic<A_U64> uEnqueuePosition;
+		alignas(64) std::atomic<A_U64> uDequeuePosition;
+
+		alignas(64) std::atomic<A_U32> uSignal; // Bumped to wake the dispatch thread, which only sleeps on it while bSleeping is set.
+		std::atomic<bool> bSleeping;
+		std::atomic<bool> bStopping;
+		std::atomic<bool> bRunning;
+
+		std::atomic<A_U64> uNextStamp;
+		CoalesceSlot szCoalesceSlots[c_uCoalesceSlots];
+
+		std::atomic<A_U64> uEnqueued;
+		std::atomic<A_U64> uDelivered;
+		std::atomic<A_U64> uDropped;
+		std::atomic<A_U64> uCoalesced;
+		std::atomic<A_U32> uMaxDepth;
+
+		std::thread DispatchThread;
+		std::unique_ptr<WorkerPool> pWorkers;
+
+		std::mutex DeferredLock;
+		std::vector<Item> Deferred;		// The invocations waiting for the render thread.
+		std::vector<Item> Dispatching;	// Only touched by the render thread.
+
+		A_U32 GetCoalesceSlot(_In_ A_LPCVOID lpEvent) noexcept;
+		bool IsSuperseded(_In_ const Item& refItem) const noexcept;
+
+		bool Push(_Inout_ Item& refItem);
+		bool Pop(_Out_ Item& refItem) noexcept;
+
+		void DispatcherMain();
+		void Deliver(_In_ const std::vector<Item>& refBatch);
+
+	public:
+		/// <param name="uCapacity">- The number of invocations the queue holds, rounded up to a power of two.</param>
+		EventQueue(_In_ A_U32 uCapacity, _In_ BackpressurePolicy Policy);
+		~EventQueue();
+
+		EventQueue(const EventQueue&) = delete;
+		EventQueue& operator=(const EventQueue&) = delete;
+
+		/// <summary>
+		/// Queues an invocation of an event. Returns false if the event has no handlers to call asynchronously.
+		/// </summary>
+		/// <param name="bDeferRenderThread">- Whether to hand the render-thread handlers back to the render thread, rather than leaving them to the caller.</param>
+		template<class TArgs>
+			requires(std::is_trivially_copyable_v<TArgs> && sizeof(TArgs) <= c_uMaxArgsSize && alignof(TArgs) <= 16)
+		inline bool Enqueue(_In_ const Aurora::Event<TArgs>& refEvent, _In_opt_ A_LPVOID lpSender, _In_opt_ const TArgs* lpArgs, _In_ bool bDeferRenderThread = true) {
+			Item NewItem;
+			NewItem.lpEvent = &refEvent;
+			NewItem.lpSender = lpSender;
+			NewItem.pfnDispatch = &Dispatch<TArgs>;
+			NewItem.bAnyThread = refEvent.HasHandlers(Aurora::EventHandlerAffinity::AnyThread);
+			NewItem.bRenderThread = bDeferRenderThread && refEvent.HasHandlers(Aurora::EventHandlerAffinity::RenderThread);
+			if (!NewItem.bAnyThread && !NewItem.bRenderThread) return false;
+
+			NewItem.bHasArgs = lpArgs != nullptr;
+			if (lpArgs) memcpy(NewItem.szArgs, lpArgs, sizeof(TArgs));
+
+			return Push(NewItem);
+		}
+
+		inline bool Enqueue(_In_ const Aurora::Event<Aurora::NullClass_t>& refEvent, _In_opt_ A_LPVOID lpSender, _In_ bool bDeferRenderThread = true) {
+			Item NewItem;
+			NewItem.lpEvent = &refEvent;
+			NewItem.lpSender = lpSender;
+			NewItem.pfnDispatch = &Dispatch<Aurora::NullClass_t>;
+			NewItem.bAnyThread = refEvent.HasHandlers(Aurora::EventHandlerAffinity::AnyThread);
+			NewItem.bRenderThread = bDeferRenderThread && refEvent.HasHandlers(Aurora::EventHandlerAffinity::RenderThread);
+			if (!NewItem.bAnyThread && !NewItem.bRenderThread) return false;
+
+			NewItem.bHasArgs = false;
+			return Push(NewItem);
+		}
+
+		/// <summary>
+		/// Starts the dispatch thread. With workers, batches of invocations are spread over them instead of being dispatched one by one.
+		/// </summary>
+		void Start(_In_ A_U32 uWorkerCount = 0);
+
+		/// <summary>
+		/// Delivers the invocations that are still queued and stops the dispatch thread.
+		/// </summary>
+		void Stop();
+
+		/// <summary>
+		/// Calls the render-thread handlers of the invocations the dispatch thread has handed back. Must be called on the render thread.
+		/// </summary>
+		void DispatchDeferred();
+
+		EventQueueStatistics GetStatistics() const noexcept;
+	};
+}
+
+#endif // !__ARTEMIS_EVENT_QUEUE_H__
\ No newline at end of file
@@ -9,8 +9,15 @@ namespace Artemis {
 #endif // _DEBUG
 
 	ARTEMIS_API DrawManagerCollection DrawManagers;
-	ARTEMIS_API DrawManager& MainDrawManager = *DrawManagers.Get(DrawManagers.AddNew());
+	ARTEMIS_API DrawManager& MainDrawManager = *DrawManagers.Get(DrawManagers.AddNew("Main"));
 	ARTEMIS_API EventManager EventEntries;
+	ARTEMIS_API EventQueue AsyncEvents(1024, BackpressurePolicy::Coalesce);
+	ARTEMIS_API FrameThrottle Throttle;
 	ARTEMIS_API KeybindManager Keybinds;
+	ARTEMIS_API WatchManager Watches;
 	ARTEMIS_API WindowManager Windows;
+
+#ifdef ARTEMIS_PROFILE
+	ARTEMIS_API FramePhaseTimings FramePhases;
+#endif // ARTEMIS_PROFILE
 }
\ No newline at end of file
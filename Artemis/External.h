@@ -8,7 +8,11 @@ using Aurora::Logger;
 #include "Definitions.h"
 #include "DrawManager.h"
 #include "EventManager.h"
+#include "EventQueue.h"
+#include "FrameThrottle.h"
 #include "KeybindManager.h"
+#include "Profiler.h"
+#include "WatchManager.h"
 #include "WindowManager.h"
 
 namespace Artemis {
@@ -19,8 +23,15 @@ namespace Artemis {
 	ARTEMIS_API extern DrawManagerCollection DrawManagers;
 	ARTEMIS_API extern DrawManager& MainDrawManager;
 	ARTEMIS_API extern EventManager EventEntries;
+	ARTEMIS_API extern EventQueue AsyncEvents;
+	ARTEMIS_API extern FrameThrottle Throttle;
 	ARTEMIS_API extern KeybindManager Keybinds;
+	ARTEMIS_API extern WatchManager Watches;
 	ARTEMIS_API extern WindowManager Windows;
+
+#ifdef ARTEMIS_PROFILE
+	ARTEMIS_API extern FramePhaseTimings FramePhases;
+#endif // ARTEMIS_PROFILE
 }
 
 #endif // !__ARTEMIS_EXTERNAL_H__
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "FrameArena.h"
+
+#include <cstdint>
+#include <new>
+
+namespace Artemis {
+	FrameArena::FrameArena() noexcept : uChunk(0), uOffset(0) {}
+
+	FrameArena::~FrameArena() {
+		for (const Chunk& refChunk : Chunks)
+			::operator delete(refChunk.lpMemory);
+	}
+
+	FrameArena& FrameArena::Current() noexcept {
+		static thread_local FrameArena Arena;
+		return Arena;
+	}
+
+	_Ret_notnull_ A_LPVOID FrameArena::Allocate(_In_ size_t uSize, _In_ size_t uAlignment) {
+		for (; uChunk < Chunks.size(); uChunk++, uOffset = 0) {
+			const Chunk& refChunk = Chunks[uChunk];
+
+			uintptr_t uBase = reinterpret_cast<uintptr_t>(refChunk.lpMemory);
+			uintptr_t uAddress = (uBase + uOffset + uAlignment - 1) & ~static_cast<uintptr_t>(uAlignment - 1);
+
+			if (uAddress + uSize <= uBase + refChunk.uSize) {
+				uOffset = uAddress + uSize - uBase;
+				return reinterpret_cast<A_LPVOID>(uAddress);
+			}
+		}
+
+		// Every chunk is full, so add one that is large enough for the allocation and start over from it.
+		size_t uChunkSize = uSize + uAlignment > c_uChunkSize ? uSize + uAlignment : c_uChunkSize;
+		Chunks.push_back({ static_cast<A_BYTE*>(::operator new(uChunkSize)), uChunkSize });
+		uChunk = Chunks.size() - 1;
+		uOffset = 0;
+
+		return Allocate(uSize, uAlignment);
+	}
+
+	void FrameArena::Reset() noexcept {
+		uChunk = 0;
+		uOffset = 0;
+	}
+
+	size_t FrameArena::GetReservedSize() const noexcept {
+		size_t uSize = 0;
+		for (const Chunk& refChunk : Chunks)
+			uSize += refChunk.uSize;
+		return uSize;
+	}
+}
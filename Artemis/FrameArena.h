@@ -0,0 +1,59 @@
+#ifndef __ARTEMIS_FRAME_ARENA_H__
+#define __ARTEMIS_FRAME_ARENA_H__
+
+#include <type_traits>
+#include <vector>
+
+#include <Aurora/Definitions.h>
+
+#include "Definitions.h"
+
+namespace Artemis {
+	/// <summary>
+	/// <para>A per-thread bump allocator for memory that only has to live until the end of the current frame.</para>
+	/// <para>Memory is carved out of chunks that are kept across resets, so once the arena has grown to the size of a frame, allocating from it never touches the heap.</para>
+	/// <para>The render thread resets its arena at the end of every present. Other threads reset theirs at the end of each of their own iterations.</para>
+	/// </summary>
+	class ARTEMIS_API FrameArena {
+		struct Chunk {
+			A_BYTE* lpMemory;
+			size_t uSize;
+		};
+
+		std::vector<Chunk> Chunks;
+		size_t uChunk;
+		size_t uOffset;
+
+	public:
+		static constexpr size_t c_uChunkSize = 64 * 1024;
+
+		FrameArena() noexcept;
+		~FrameArena();
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		/// <summary>
+		/// Gets the arena of the calling thread.
+		/// </summary>
+		static FrameArena& Current() noexcept;
+
+		_Ret_notnull_ A_LPVOID Allocate(_In_ size_t uSize, _In_ size_t uAlignment);
+
+		/// <summary>
+		/// Allocates uninitialized storage for an array. The elements are never destroyed, so only trivially destructible types are allowed.
+		/// </summary>
+		template<class T>
+			requires(std::is_trivially_destructible_v<T>)
+		inline _Ret_notnull_ T* Allocate(_In_ size_t uCount) { return static_cast<T*>(Allocate(sizeof(T) * uCount, alignof(T))); }
+
+		/// <summary>
+		/// Releases everything allocated since the last reset, keeping the chunks for the next frame.
+		/// </summary>
+		void Reset() noexcept;
+
+		size_t GetReservedSize() const noexcept;
+	};
+}
+
+#endif // !__ARTEMIS_FRAME_ARENA_H__
@@ -0,0 +1,57 @@
+#include "FrameThrottle.h"
+
+namespace Artemis {
+	FrameThrottle::FrameThrottle(_In_ A_U32 uUpdateRate) noexcept :
+		uUpdateRate(uUpdateRate),
+		bInput(false),
+		bUpdateRequested(false),
+		uLastUpdate(0),
+		bBuilt(false),
+		uBuiltFrames(0),
+		uReplayedFrames(0)
+	{}
+
+	void FrameThrottle::SetUpdateRate(_In_ A_U32 uUpdateRate) noexcept { this->uUpdateRate.store(uUpdateRate, std::memory_order_relaxed); }
+	A_U32 FrameThrottle::GetUpdateRate() const noexcept { return uUpdateRate.load(std::memory_order_relaxed); }
+
+	void FrameThrottle::NotifyInput() noexcept { bInput.store(true, std::memory_order_relaxed); }
+	void FrameThrottle::RequestUpdate() noexcept { bUpdateRequested.store(true, std::memory_order_relaxed); }
+
+	bool FrameThrottle::ShouldUpdate(_In_ A_U64 uNow, _In_ FrameDemand Demand) noexcept {
+		A_U32 uRate = uUpdateRate.load(std::memory_order_relaxed);
+		A_U64 uPeriod = uRate ? 1000000000ULL / uRate : 0;
+
+		A_U64 uElapsed = uNow - uLastUpdate;
+
+		if (bBuilt && uRate && Demand != FrameDemand::EveryFrame) {
+			// A frame that is a little early still counts as due, so a game that presents at about the update rate is not halved by its jitter.
+			bool bReplay = uElapsed + uPeriod / 16 < uPeriod;
+			if (!bReplay && Demand == FrameDemand::None && !bInput.load(std::memory_order_relaxed) && !bUpdateRequested.load(std::memory_order_relaxed))
+				bReplay = true;
+
+			if (bReplay) {
+				uReplayedFrames.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+		}
+
+		// Cleared before the build, so what arrives during it builds the UI again.
+		bInput.store(false, std::memory_order_relaxed);
+		bUpdateRequested.store(false, std::memory_order_relaxed);
+
+		// Keep to the cadence of the update rate, but skip the updates that were missed rather than catching up on them.
+		if (bBuilt && uRate && uElapsed >= uPeriod && uElapsed < 2 * uPeriod) uLastUpdate += uPeriod;
+		else uLastUpdate = uNow;
+
+		bBuilt = true;
+		uBuiltFrames.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	FrameThrottleStatistics FrameThrottle::GetStatistics() const noexcept {
+		FrameThrottleStatistics Statistics;
+		Statistics.uBuiltFrames = uBuiltFrames.load(std::memory_order_relaxed);
+		Statistics.uReplayedFrames = uReplayedFrames.load(std::memory_order_relaxed);
+		return Statistics;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef __ARTEMIS_FRAME_THROTTLE_H__
+#define __ARTEMIS_FRAME_THROTTLE_H__
+
+#include <atomic>
+
+#include <Aurora/Definitions.h>
+
+#include "Definitions.h"
+
+namespace Artemis {
+	enum class FrameDemand : int {
+		None,		// Nothing the UI draws has changed.
+		Dirty,		// Something the UI draws has changed, so it is built again once the update rate allows.
+		EveryFrame	// Something the UI draws changes on every frame, like a world-space overlay, so it is built on every frame regardless of the update rate.
+	};
+
+	struct FrameThrottleStatistics {
+		A_U64 uBuiltFrames;		// The frames the UI was built on.
+		A_U64 uReplayedFrames;	// The frames that submitted the draw data of the last built frame again.
+	};
+
+	/// <summary>
+	/// <para>Limits how often the UI is built, so a game that presents far more frames than the UI needs does not pay for building it on every one.</para>
+	/// <para>The UI is built at most at the update rate, and only when input arrived, an update was requested or the caller reports that something is dirty. Other frames submit the draw data of the last built frame again.</para>
+	/// <para>A caller that reports something drawn on every frame has the UI built on every frame.</para>
+	/// <para>NotifyInput and RequestUpdate may be called from any thread. ShouldUpdate is only to be called from the render thread.</para>
+	/// </summary>
+	class ARTEMIS_API FrameThrottle {
+	public:
+		static constexpr A_U32 c_uDefaultUpdateRate = 60;
+
+	private:
+		std::atomic<A_U32> uUpdateRate;
+		std::atomic<bool> bInput;
+		std::atomic<bool> bUpdateRequested;
+
+		// Only touched by the render thread.
+		A_U64 uLastUpdate; // The time the UI was last built, in nanoseconds.
+		bool bBuilt;
+
+		std::atomic<A_U64> uBuiltFrames;
+		std::atomic<A_U64> uReplayedFrames;
+
+	public:
+		/// <param name="uUpdateRate">- The most times per second the UI is built, or 0 to build it on every frame.</param>
+		explicit FrameThrottle(_In_ A_U32 uUpdateRate = c_uDefaultUpdateRate) noexcept;
+
+		FrameThrottle(const FrameThrottle&) = delete;
+		FrameThrottle& operator=(const FrameThrottle&) = delete;
+
+		void SetUpdateRate(_In_ A_U32 uUpdateRate) noexcept;
+		A_U32 GetUpdateRate() const noexcept;
+
+		/// <summary>
+		/// Reports input that the UI may react to, like a window message that ImGui handles.
+		/// </summary>
+		void NotifyInput() noexcept;
+
+		/// <summary>
+		/// Makes the UI build again once the update rate allows it, for changes that do not come with input.
+		/// </summary>
+		void RequestUpdate() noexcept;
+
+		/// <summary>
+		/// Decides whether the UI is built on the current frame, or the last built draw data is submitted again.
+		/// </summary>
+		/// <param name="uNow">- The current time, in nanoseconds of the steady clock.</param>
+		/// <param name="Demand">- Whether something the UI draws has changed since it was last built, or changes on every frame.</param>
+		bool ShouldUpdate(_In_ A_U64 uNow, _In_ FrameDemand Demand) noexcept;
+
+		FrameThrottleStatistics GetStatistics() const noexcept;
+	};
+}
+
+#endif // !__ARTEMIS_FRAME_THROTTLE_H__
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "pch.h"
+#include "GameStateDispatcher.h"
+
+#include <bit>
+
+namespace Artemis::Engine {
+	namespace {
+		// States outside of the known range are treated as invalid, rather than indexing past the table.
+		constexpr A_U32 ToIndex(_In_ GameState State) noexcept {
+			A_U32 uIndex = static_cast<A_U32>(State);
+			return uIndex < GameStateDispatcher::c_uStateCount ? uIndex : static_cast<A_U32>(GameState::Invalid);
+		}
+	}
+
+	GameStateDispatcher::GameStateDispatcher(_In_ const GameManager& refGame, _In_ GameState InitialState) : Game(refGame), PreviousGameState(InitialState), CurrentGameState(InitialState), uHandlerCount(0) {
+		ZeroMemory(szpfnHandlers, sizeof(szpfnHandlers));
+		ZeroMemory(szuTransitions, sizeof(szuTransitions));
+	}
+
+	A_U32 GameStateDispatcher::GetHandlerBit(_In_ TransitionHandler pfnHandler) noexcept {
+		for (A_U32 i = 0; i < uHandlerCount; i++)
+			if (szpfnHandlers[i] == pfnHandler)
+				return 1U << i;
+
+		if (uHandlerCount == c_uMaxHandlers) return 0;
+
+		szpfnHandlers[uHandlerCount] = pfnHandler;
+		return 1U << uHandlerCount++;
+	}
+
+	bool GameStateDispatcher::Subscribe(_In_ GameState From, _In_ GameState To, _In_ TransitionHandler pfnHandler) {
+		A_U32 uFrom = ToIndex(From), uTo = ToIndex(To);
+		if (uFrom == uTo) return false;
+
+		A_U32 uBit = GetHandlerBit(pfnHandler);
+		if (!uBit) return false;
+
+		szuTransitions[uFrom][uTo] |= uBit;
+		return true;
+	}
+
+	bool GameStateDispatcher::Subscribe(_In_ GameState To, _In_ TransitionHandler pfnHandler) {
+		A_U32 uTo = ToIndex(To);
+
+		A_U32 uBit = GetHandlerBit(pfnHandler);
+		if (!uBit) return false;
+
+		for (A_U32 uFrom = 0; uFrom < c_uStateCount; uFrom++)
+			if (uFrom != uTo)
+				szuTransitions[uFrom][uTo] |= uBit;
+		return true;
+	}
+
+	bool GameStateDispatcher::Condition() {
+		GameState State = Game.GetGameState();
+		if (ToIndex(State) == ToIndex(CurrentGameState)) return false;
+
+		PreviousGameState = CurrentGameState;
+		CurrentGameState = State;
+		return szuTransitions[ToIndex(PreviousGameState)][ToIndex(CurrentGameState)] != 0;
+	}
+
+	void GameStateDispatcher::Invoke() {
+		for (A_U32 uMask = szuTransitions[ToIndex(PreviousGameState)][ToIndex(CurrentGameState)]; uMask; uMask &= uMask - 1)
+			szpfnHandlers[std::countr_zero(uMask)](this);
+	}
+}
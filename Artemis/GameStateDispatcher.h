@@ -0,0 +1,55 @@
+#ifndef __ARTEMIS_ENGINE_GAME_STATE_DISPATCHER_H__
+#define __ARTEMIS_ENGINE_GAME_STATE_DISPATCHER_H__
+
+#include <Aurora/Definitions.h>
+
+#include "Definitions.h"
+#include "EventManager.h"
+#include "GameManager.h"
+
+namespace Artemis::Engine {
+	/// <summary>
+	/// <para>An event entry that reads the game state once per frame and, when it changes, calls the handlers subscribed to the transition from the previous state.</para>
+	/// <para>Handlers are looked up in a table indexed by the previous and the current state, so neither the number of states nor the number of transitions adds reads or checks.</para>
+	/// <para>Subscribe before the dispatcher is added to an event manager.</para>
+	/// </summary>
+	class GameStateDispatcher : public IEventEntry {
+	public:
+		using TransitionHandler = void(*)(_In_ GameStateDispatcher* pSender);
+
+		static constexpr A_U32 c_uStateCount = static_cast<A_U32>(GameState::PlayerControlAllowed) + 1;
+		static constexpr A_U32 c_uMaxHandlers = 32;
+
+	private:
+		GameManager Game;
+		GameState PreviousGameState;
+		GameState CurrentGameState;
+
+		TransitionHandler szpfnHandlers[c_uMaxHandlers];
+		A_U32 uHandlerCount;
+		A_U32 szuTransitions[c_uStateCount][c_uStateCount]; // A mask of the handlers to call for each pair of previous and current state.
+
+		A_U32 GetHandlerBit(_In_ TransitionHandler pfnHandler) noexcept;
+
+	public:
+		GameStateDispatcher(_In_ const GameManager& refGame, _In_ GameState InitialState = GameState::MainMenu);
+
+		/// <summary>
+		/// Calls pfnHandler whenever the state changes from From to To. Returns false if there is no room for another handler.
+		/// </summary>
+		bool Subscribe(_In_ GameState From, _In_ GameState To, _In_ TransitionHandler pfnHandler);
+
+		/// <summary>
+		/// Calls pfnHandler whenever the state changes to To from any other state. Returns false if there is no room for another handler.
+		/// </summary>
+		bool Subscribe(_In_ GameState To, _In_ TransitionHandler pfnHandler);
+
+		constexpr GameState GetGameState() const noexcept { return CurrentGameState; }
+		constexpr GameState GetPreviousGameState() const noexcept { return PreviousGameState; }
+
+		virtual bool Condition() final;
+		virtual void Invoke() final;
+	};
+}
+
+#endif // !__ARTEMIS_ENGINE_GAME_STATE_DISPATCHER_H__
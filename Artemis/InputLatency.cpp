@@ -0,0 +1,112 @@
+#include "InputLatency.h"
+
+#include <fstream>
+
+namespace Artemis {
+	void LatencyHistogram::Add(_In_ A_U64 uLatency) noexcept {
+		szuBuckets[GetBucket(uLatency)]++;
+		uTotal += uLatency;
+		if (!uCount || uLatency < uMinimum) uMinimum = uLatency;
+		if (uLatency > uMaximum) uMaximum = uLatency;
+		uCount++;
+	}
+
+	A_U64 LatencyHistogram::GetPercentile(_In_ A_FL64 fFraction) const noexcept {
+		if (!uCount) return 0;
+
+		A_U64 uRank = static_cast<A_U64>(fFraction * static_cast<A_FL64>(uCount));
+		if (uRank >= uCount) uRank = uCount - 1;
+
+		A_U64 uSeen = 0;
+		for (A_U32 i = 0; i < c_uBucketCount; i++) {
+			uSeen += szuBuckets[i];
+			if (uSeen > uRank) {
+				A_U64 uUpperBound = GetUpperBound(i) * 1000;
+				return i + 1 < c_uBucketCount && uUpperBound < uMaximum ? uUpperBound : uMaximum;
+			}
+		}
+
+		return uMaximum;
+	}
+
+	InputLatency::InputLatency() : szActions(), uHead(0), uTail(0), uDropped(0), uFrameHead(0) {}
+
+	bool InputLatency::Record(_In_ const char* lpTypeName, _In_ A_U32 uKey, _In_ KeyModifiers Modifiers, _In_ A_U64 uInputTime, _In_ A_U64 uActionTime) noexcept {
+		A_U32 uPosition = uHead.load(std::memory_order_relaxed);
+
+		if (uPosition - uTail.load(std::memory_order_acquire) == c_uCapacity) {
+			uDropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		szActions[uPosition % c_uCapacity] = { lpTypeName, uKey, Modifiers, uInputTime, uActionTime };
+		uHead.store(uPosition + 1, std::memory_order_release);
+		return true;
+	}
+
+	void InputLatency::BeginFrame() noexcept { uFrameHead = uHead.load(std::memory_order_acquire); }
+
+	BindingLatency& InputLatency::GetBinding(_In_ const Action& refAction) {
+		// There are few keybinds, and the ones that fired last are the likeliest to fire again.
+		for (size_t i = Bindings.size(); i-- > 0;) {
+			BindingLatency& refBinding = Bindings[i];
+			if (refBinding.lpTypeName == refAction.lpTypeName && refBinding.uKey == refAction.uKey && refBinding.Modifiers == refAction.Modifiers)
+				return refBinding;
+		}
+
+		BindingLatency& refBinding = Bindings.emplace_back();
+		refBinding.lpTypeName = refAction.lpTypeName;
+		refBinding.uKey = refAction.uKey;
+		refBinding.Modifiers = refAction.Modifiers;
+		return refBinding;
+	}
+
+	void InputLatency::Present(_In_ A_U64 uPresentTime) {
+		A_U32 uPosition = uTail.load(std::memory_order_relaxed);
+
+		for (; uPosition != uFrameHead; uPosition++) {
+			const Action& refAction = szActions[uPosition % c_uCapacity];
+			BindingLatency& refBinding = GetBinding(refAction);
+
+			A_U64 uLatency = uPresentTime - refAction.uInputTime;
+			refBinding.ToAction.Add(refAction.uActionTime - refAction.uInputTime);
+			refBinding.ToPresent.Add(uLatency);
+			Total.Add(uLatency);
+		}
+
+		uTail.store(uPosition, std::memory_order_release);
+	}
+
+	void InputLatency::Reset() noexcept {
+		Bindings.clear();
+		Total = LatencyHistogram();
+	}
+
+	const std::vector<BindingLatency>& InputLatency::GetBindings() const noexcept { return Bindings; }
+	const LatencyHistogram& InputLatency::GetTotal() const noexcept { return Total; }
+	A_U64 InputLatency::GetDroppedCount() const noexcept { return uDropped.load(std::memory_order_relaxed); }
+
+	bool InputLatency::Export(_In_z_ const char* lpFileName) const {
+		std::ofstream File(lpFileName, std::ios::out | std::ios::trunc);
+		if (!File) return false;
+
+		File << "Keybind,Key,Modifiers,From (us),To (us),To action,To present\n";
+
+		for (const BindingLatency& refBinding : Bindings) {
+			for (A_U32 i = 0; i < LatencyHistogram::c_uBucketCount; i++) {
+				if (!refBinding.ToAction.szuBuckets[i] && !refBinding.ToPresent.szuBuckets[i]) continue;
+
+				File << refBinding.lpTypeName << ','
+					<< refBinding.uKey << ','
+					<< static_cast<A_U32>(refBinding.Modifiers) << ','
+					<< LatencyHistogram::GetLowerBound(i) << ','
+					<< LatencyHistogram::GetUpperBound(i) << ','
+					<< refBinding.ToAction.szuBuckets[i] << ','
+					<< refBinding.ToPresent.szuBuckets[i] << '\n';
+			}
+		}
+
+		File.close();
+		return !File.fail();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+#ifndef __ARTEMIS_INPUT_LATENCY_H__
+#define __ARTEMIS_INPUT_LATENCY_H__
+
+#include <atomic>
+#include <bit>
+#include <vector>
+
+#include <Aurora/Definitions.h>
+
+#include "Definitions.h"
+#include "KeyboardState.h"
+
+namespace Artemis {
+	/// <summary>
+	/// A histogram of latencies, with four buckets per power of two microseconds, so that every bucket is at most a quarter as wide as the latencies in it.
+	/// </summary>
+	struct LatencyHistogram {
+		static constexpr A_U32 c_uSubBucketCount = 4;
+		static constexpr A_U32 c_uBucketCount = 80; // Reaches up to 2^21 microseconds. The last bucket also holds the latencies past it.
+
+		/// <summary>
+		/// Gets the bucket of a latency given in nanoseconds.
+		/// </summary>
+		static constexpr A_U32 GetBucket(_In_ A_U64 uLatency) noexcept {
+			A_U64 uMicroseconds = uLatency / 1000;
+			if (uMicroseconds < c_uSubBucketCount) return static_cast<A_U32>(uMicroseconds);
+
+			A_U32 uExponent = static_cast<A_U32>(std::bit_width(uMicroseconds)) - 1;
+			A_U32 uBucket = (uExponent - 1) * c_uSubBucketCount + static_cast<A_U32>((uMicroseconds >> (uExponent - 2)) & (c_uSubBucketCount - 1));
+			return uBucket < c_uBucketCount ? uBucket : c_uBucketCount - 1;
+		}
+
+		/// <summary>
+		/// Gets the smallest latency of a bucket, in microseconds.
+		/// </summary>
+		static constexpr A_U64 GetLowerBound(_In_ A_U32 uBucket) noexcept {
+			if (uBucket < c_uSubBucketCount) return uBucket;
+			return static_cast<A_U64>(c_uSubBucketCount + uBucket % c_uSubBucketCount) << (uBucket / c_uSubBucketCount - 1);
+		}
+
+		static constexpr A_U64 GetUpperBound(_In_ A_U32 uBucket) noexcept { return GetLowerBound(uBucket + 1); }
+
+		A_U64 szuBuckets[c_uBucketCount];
+		A_U64 uCount;
+		A_U64 uTotal;		// In nanoseconds, for the average.
+		A_U64 uMinimum;		// In nanoseconds.
+		A_U64 uMaximum;		// In nanoseconds.
+
+		constexpr LatencyHistogram() noexcept : szuBuckets(), uCount(0), uTotal(0), uMinimum(0), uMaximum(0) {}
+
+		void Add(_In_ A_U64 uLatency) noexcept;
+
+		/// <summary>
+		/// Gets the latency that the given fraction of the latencies do not exceed, in nanoseconds. The result is the upper bound of its bucket, clamped to the maximum, or the maximum if it falls in the last bucket.
+		/// </summary>
+		A_U64 GetPercentile(_In_ A_FL64 fFraction) const noexcept;
+
+		constexpr A_U64 GetAverage() const noexcept { return uCount ? uTotal / uCount : 0; }
+	};
+
+	struct BindingLatency {
+		const char* lpTypeName;
+		A_U32 uKey;
+		KeyModifiers Modifiers;
+		LatencyHistogram ToAction;	// From the key transition to calling the keybind.
+		LatencyHistogram ToPresent;	// From the key transition to presenting the first frame drawn after the keybind was called.
+	};
+
+	/// <summary>
+	/// <para>Measures the time from a key transition to the frame that shows what its keybind did, per keybind.</para>
+	/// <para>The keybind thread records every keybind call in a fixed-size ring, together with the time of the transition that triggered it. The render thread takes the calls recorded before it starts a frame in BeginFrame, and adds them to the histograms of their keybinds once the frame is presented in Present.</para>
+	/// <para>Record must only be called from one thread at a time. Everything else is only to be called from the render thread.</para>
+	/// </summary>
+	class ARTEMIS_API InputLatency {
+	public:
+		static constexpr A_U32 c_uCapacity = 1024;
+
+	private:
+		struct Action {
+			const char* lpTypeName;
+			A_U32 uKey;
+			KeyModifiers Modifiers;
+			A_U64 uInputTime;
+			A_U64 uActionTime;
+		};
+
+		Action szActions[c_uCapacity];
+
+		alignas(64) std::atomic<A_U32> uHead;	// Only advanced by the recording thread.
+		alignas(64) std::atomic<A_U32> uTail;	// Only advanced by the render thread.
+		std::atomic<A_U64> uDropped;
+
+		// Only touched by the render thread.
+		A_U32 uFrameHead; // The head of the ring when the current frame was started.
+		std::vector<BindingLatency> Bindings;
+		LatencyHistogram Total;
+
+		BindingLatency& GetBinding(_In_ const Action& refAction);
+
+	public:
+		InputLatency();
+
+		InputLatency(const InputLatency&) = delete;
+		InputLatency& operator=(const InputLatency&) = delete;
+
+		/// <summary>
+		/// Records a keybind call. Returns false and drops it if the ring is full.
+		/// </summary>
+		/// <param name="uInputTime">- The time of the key transition that triggered the call, in nanoseconds of the clock of the input queue.</param>
+		/// <param name="uActionTime">- The time the keybind was called, on the same clock.</param>
+		bool Record(_In_ const char* lpTypeName, _In_ A_U32 uKey, _In_ KeyModifiers Modifiers, _In_ A_U64 uInputTime, _In_ A_U64 uActionTime) noexcept;
+
+		/// <summary>
+		/// Marks the keybind calls recorded so far as drawn by the frame that is being started.
+		/// </summary>
+		void BeginFrame() noexcept;
+
+		/// <summary>
+		/// Adds the keybind calls drawn by the current frame to the histograms, as presented at uPresentTime.
+		/// </summary>
+		void Present(_In_ A_U64 uPresentTime);
+
+		void Reset() noexcept;
+
+		const std::vector<BindingLatency>& GetBindings() const noexcept;
+		const LatencyHistogram& GetTotal() const noexcept;
+		A_U64 GetDroppedCount() const noexcept;
+
+		/// <summary>
+		/// Writes the histograms to a CSV file, a row per keybind and bucket. Returns false if the file could not be written.
+		/// </summary>
+		bool Export(_In_z_ const char* lpFileName) const;
+	};
+}
+
+#endif // !__ARTEMIS_INPUT_LATENCY_H__
\ No newline at end of file
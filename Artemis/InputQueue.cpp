@@ -0,0 +1,103 @@
+#include "InputQueue.h"
+
+namespace Artemis {
+	InputQueue::InputQueue() :
+		uEnqueuePosition(0),
+		uDequeuePosition(0),
+		uSignal(0),
+		bSleeping(false),
+		bInterrupted(false),
+		uReleasePosition(0),
+		uReleaseTimestamp(0),
+		uDropped(0)
+	{
+		for (A_U64 i = 0; i < c_uCapacity; i++) {
+			szCells[i].uSequence.store(i, std::memory_order_relaxed);
+			szCells[i].Event = {};
+		}
+	}
+
+	void InputQueue::Wake() noexcept {
+		if (bSleeping.load()) {
+			uSignal.fetch_add(1);
+			uSignal.notify_one();
+		}
+	}
+
+	void InputQueue::Drop(_In_ const InputEvent& refEvent, _In_ A_U64 uPosition) noexcept {
+		uDropped.fetch_add(1, std::memory_order_relaxed);
+		uReleaseTimestamp.store(refEvent.uTimestamp, std::memory_order_relaxed);
+
+		// Producers may drop at the same time, so only ever move the release later.
+		for (A_U64 uRelease = uReleasePosition.load(std::memory_order_relaxed); uRelease < uPosition + 1 && !uReleasePosition.compare_exchange_weak(uRelease, uPosition + 1););
+
+		Wake();
+	}
+
+	bool InputQueue::Push(_In_ const InputEvent& refEvent) noexcept {
+		A_U64 uPosition = uEnqueuePosition.load(std::memory_order_relaxed);
+
+		while (true) {
+			Cell& refCell = szCells[uPosition % c_uCapacity];
+			A_I64 nDifference = static_cast<A_I64>(refCell.uSequence.load(std::memory_order_acquire) - uPosition);
+
+			if (nDifference == 0) {
+				if (uEnqueuePosition.compare_exchange_weak(uPosition, uPosition + 1)) {
+					refCell.Event = refEvent;
+					refCell.uSequence.store(uPosition + 1, std::memory_order_release);
+
+					Wake();
+					return true;
+				}
+			}
+			else if (nDifference < 0) {
+				// The cell still holds the transition pushed a lap ago, so the queue is full.
+				Drop(refEvent, uPosition);
+				return false;
+			}
+			else uPosition = uEnqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	bool InputQueue::Pop(_Out_ InputEvent& refEvent) noexcept {
+		A_U64 uPosition = uDequeuePosition.load(std::memory_order_relaxed);
+
+		// Every transition queued before the drop has been taken. A producer that drops again in the meantime moves the release later, and it is taken then instead.
+		A_U64 uRelease = uReleasePosition.load(std::memory_order_acquire);
+		if (uRelease && uPosition + 1 >= uRelease && uReleasePosition.compare_exchange_strong(uRelease, 0, std::memory_order_acq_rel)) {
+			refEvent = { uReleaseTimestamp.load(std::memory_order_relaxed), c_uAllKeys, false };
+			return true;
+		}
+
+		Cell& refCell = szCells[uPosition % c_uCapacity];
+		if (refCell.uSequence.load(std::memory_order_acquire) != uPosition + 1) return false; // The queue is empty, or the next transition is still being written.
+
+		refEvent = refCell.Event;
+		refCell.uSequence.store(uPosition + c_uCapacity, std::memory_order_release);
+		uDequeuePosition.store(uPosition + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	bool InputQueue::IsEmpty() const noexcept {
+		return uDequeuePosition.load(std::memory_order_relaxed) == uEnqueuePosition.load() && !uReleasePosition.load();
+	}
+
+	void InputQueue::Wait() noexcept {
+		// Announce the sleep before checking the queue one last time, so a pusher either sees the announcement or its transition is seen here.
+		A_U32 uObserved = uSignal.load();
+		bSleeping.store(true);
+		if (IsEmpty() && !bInterrupted.load())
+			uSignal.wait(uObserved);
+		bSleeping.store(false);
+
+		bInterrupted.store(false);
+	}
+
+	void InputQueue::Interrupt() noexcept {
+		bInterrupted.store(true);
+		uSignal.fetch_add(1);
+		uSignal.notify_one();
+	}
+
+	A_U64 InputQueue::GetDroppedCount() const noexcept { return uDropped.load(std::memory_order_relaxed); }
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#ifndef __ARTEMIS_INPUT_QUEUE_H__
+#define __ARTEMIS_INPUT_QUEUE_H__
+
+#include <atomic>
+
+#include <Aurora/Definitions.h>
+
+#include "Definitions.h"
+
+namespace Artemis {
+	struct InputEvent {
+		A_U64 uTimestamp;	// The time the transition was posted, in nanoseconds of the steady clock.
+		A_U32 uKey;			// The virtual key code, or c_uAllKeys.
+		bool bDown;
+	};
+
+	/// <summary>
+	/// <para>A fixed-size ring of key transitions, passed from the threads that receive input to the thread that handles it.</para>
+	/// <para>Push and Pop do not lock. Any number of threads may push, but there must be only one popping thread at a time.</para>
+	/// <para>A transition that does not fit is dropped. Since a dropped release would leave its key held, every drop makes Pop release every key once the transitions queued before the drop have been popped.</para>
+	/// <para>Wait blocks the popping thread on the OS until a transition is pushed or Interrupt is called, so an idle consumer costs no CPU.</para>
+	/// </summary>
+	class ARTEMIS_API InputQueue {
+	public:
+		static constexpr A_U32 c_uCapacity = 256;
+		static constexpr A_U32 c_uAllKeys = 0; // A key code no key has, used to release every key at once.
+
+	private:
+		struct Cell {
+			std::atomic<A_U64> uSequence;
+			InputEvent Event;
+		};
+
+		Cell szCells[c_uCapacity];
+
+		alignas(64) std::atomic<A_U64> uEnqueuePosition;
+		alignas(64) std::atomic<A_U64> uDequeuePosition; // Only advanced by the popping thread.
+
+		alignas(64) std::atomic<A_U32> uSignal; // Bumped to wake the popping thread, which only sleeps on it while bSleeping is set.
+		std::atomic<bool> bSleeping;
+		std::atomic<bool> bInterrupted;
+
+		std::atomic<A_U64> uReleasePosition;	// One past the position of the last dropped transition, or 0 if every key has been released since.
+		std::atomic<A_U64> uReleaseTimestamp;	// The time of the last dropped transition.
+		std::atomic<A_U64> uDropped;
+
+		void Drop(_In_ const InputEvent& refEvent, _In_ A_U64 uPosition) noexcept;
+		void Wake() noexcept;
+
+	public:
+		InputQueue();
+
+		InputQueue(const InputQueue&) = delete;
+		InputQueue& operator=(const InputQueue&) = delete;
+
+		/// <summary>
+		/// Queues a transition. Returns false and drops it if the queue is full, in which case every key is released after the transitions queued before it.
+		/// </summary>
+		bool Push(_In_ const InputEvent& refEvent) noexcept;
+
+		/// <summary>
+		/// Takes the next transition, which releases every key if one was dropped after the transitions taken so far.
+		/// </summary>
+		bool Pop(_Out_ InputEvent& refEvent) noexcept;
+
+		bool IsEmpty() const noexcept;
+
+		/// <summary>
+		/// Blocks until the queue is not empty or Interrupt is called.
+		/// </summary>
+		void Wait() noexcept;
+
+		/// <summary>
+		/// Wakes the popping thread from Wait, or makes its next call to Wait return right away.
+		/// </summary>
+		void Interrupt() noexcept;
+
+		A_U64 GetDroppedCount() const noexcept;
+	};
+}
+
+#endif // !__ARTEMIS_INPUT_QUEUE_H__
\ No newline at end of file
@@ -1,15 +1,144 @@
 #include "pch.h"
 #include "KeybindManager.h"
 
+#include <chrono>
+
 namespace Artemis {
-	void IKeybind::Invoke() {
-		if (GetAsyncKeyState((int)nKey) & (1 << (Aurora::Binary<SHORT>::BufferBitCount - 1)))
-			OnKeyPress();
+	bool IKeybind::IsKeyDown() const { return GetAsyncKeyState((int)nKey) & (1 << (Aurora::Binary<SHORT>::BufferBitCount - 1)); }
+
+	KeybindManager::KeybindManager() :
+		uCompiledEpoch(~0ULL),
+		uTransitions(0),
+		uPresses(0),
+		uKeybindCalls(0),
+		uWakeups(0),
+		uBusyTime(0),
+		uIdleTime(0),
+		uLastLatency(0),
+		uMaxLatency(0),
+		uTotalLatency(0),
+		uBusySince(0)
+	{}
+
+	KeybindManager::Handle KeybindManager::Add(_In_ IKeybind* pKeybind) {
+		Handle hKeybind = Manager<IKeybind>::Add(pKeybind);
+		Interrupt();
+		return hKeybind;
+	}
+
+	void KeybindManager::Release() {
+		Manager<IKeybind>::Release();
+		Interrupt();
+	}
+
+	void KeybindManager::Release(_In_ Handle hKeybind) {
+		Manager<IKeybind>::Release(hKeybind);
+		Interrupt();
+	}
+
+	A_U64 KeybindManager::GetTimestamp() noexcept { return static_cast<A_U64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()); }
+
+	bool KeybindManager::Post(_In_ A_U32 uKey, _In_ bool bDown) noexcept {
+		if (uKey == InputQueue::c_uAllKeys || uKey >= 256) return false;
+		return Input.Push({ GetTimestamp(), uKey, bDown });
+	}
+
+	bool KeybindManager::PostReleaseAll() noexcept { return Input.Push({ GetTimestamp(), InputQueue::c_uAllKeys, false }); }
+
+	void KeybindManager::Compile(_In_ const Snapshot* pSnapshot) {
+		uCompiledEpoch = pSnapshot->uEpoch;
+
+		Matcher.Clear();
+		Invokers.assign(pSnapshot->Objects.size(), nullptr);
+
+		// The snapshot is in priority order, which the matcher keeps among keybinds with as many modifiers.
+		for (const Run& refRun : pSnapshot->Runs) {
+			for (A_U32 i = refRun.uBegin; i < refRun.uBegin + refRun.uCount; i++) {
+				const IKeybind* pKeybind = pSnapshot->Objects[i];
+				Matcher.Add(i, static_cast<A_U32>(pKeybind->GetKey()), pKeybind->GetModifiers(), pKeybind->GetTriggers(), pKeybind->IsExclusive());
+				Invokers[i] = refRun.pfnInvoke;
+			}
+		}
+
+		Matcher.Compile();
+	}
+
+	void KeybindManager::Call(_In_ const Snapshot* pSnapshot, _In_ const KeybindMatch& refMatch) {
+		const IKeybind* pKeybind = pSnapshot->Objects[refMatch.uBinding];
+		const InvokeContext Context = { refMatch.Trigger };
+
+		Range InvocationRange;
+		InvocationRange.ppObjects = pSnapshot->Objects.data() + refMatch.uBinding;
+#ifdef ARTEMIS_PROFILE
+		InvocationRange.ppTimings = pSnapshot->Timings.data() + refMatch.uBinding;
+#endif // ARTEMIS_PROFILE
+		InvocationRange.uCount = 1;
+
+		Invokers[refMatch.uBinding](InvocationRange, Context);
+		uKeybindCalls.fetch_add(1, std::memory_order_relaxed);
+		Latency.Record(typeid(*pKeybind).name(), refMatch.uKey, pKeybind->GetModifiers(), refMatch.uTimestamp, GetTimestamp());
 	}
 
 	void KeybindManager::Invoke() {
-		for (IKeybind* pKeybind : InvocableCollection)
-			if (pKeybind)
-				pKeybind->Invoke();
+		const Snapshot* pSnapshot = AcquireSnapshot();
+		if (pSnapshot->uEpoch != uCompiledEpoch)
+			Compile(pSnapshot);
+
+		InputEvent Event;
+		while (Input.Pop(Event)) {
+			uTransitions.fetch_add(1, std::memory_order_relaxed);
+			Matcher.Apply(Event);
+		}
+		Matcher.Flush();
+
+		const KeybindMatch* pPrevious = nullptr;
+		for (const KeybindMatch& refMatch : Matcher.GetMatches()) {
+			// The matches of a press are reported together, so a press is new unless the match before it was of the same press.
+			bool bNewPress = refMatch.Trigger == KeybindTrigger::Press && !(pPrevious && pPrevious->Trigger == KeybindTrigger::Press && pPrevious->uKey == refMatch.uKey && pPrevious->uTimestamp == refMatch.uTimestamp);
+			pPrevious = &refMatch;
+
+			if (bNewPress) {
+				A_U64 uLatency = GetTimestamp() - refMatch.uTimestamp;
+				uPresses.fetch_add(1, std::memory_order_relaxed);
+				uLastLatency.store(uLatency, std::memory_order_relaxed);
+				uTotalLatency.fetch_add(uLatency, std::memory_order_relaxed);
+				if (uLatency > uMaxLatency.load(std::memory_order_relaxed))
+					uMaxLatency.store(uLatency, std::memory_order_relaxed);
+			}
+
+			Call(pSnapshot, refMatch);
+		}
+		Matcher.ClearMatches();
 	}
+
+	void KeybindManager::Wait() {
+		A_U64 uNow = GetTimestamp();
+		if (uBusySince)
+			uBusyTime.fetch_add(uNow - uBusySince, std::memory_order_relaxed);
+
+		Input.Wait();
+
+		uBusySince = GetTimestamp();
+		uIdleTime.fetch_add(uBusySince - uNow, std::memory_order_relaxed);
+		uWakeups.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void KeybindManager::Interrupt() noexcept { Input.Interrupt(); }
+
+	KeybindStatistics KeybindManager::GetStatistics() const noexcept {
+		KeybindStatistics Statistics;
+		Statistics.uTransitions = uTransitions.load(std::memory_order_relaxed);
+		Statistics.uDropped = Input.GetDroppedCount();
+		Statistics.uPresses = uPresses.load(std::memory_order_relaxed);
+		Statistics.uKeybindCalls = uKeybindCalls.load(std::memory_order_relaxed);
+		Statistics.uWakeups = uWakeups.load(std::memory_order_relaxed);
+		Statistics.uBusyTime = uBusyTime.load(std::memory_order_relaxed);
+		Statistics.uIdleTime = uIdleTime.load(std::memory_order_relaxed);
+		Statistics.uLastLatency = uLastLatency.load(std::memory_order_relaxed);
+		Statistics.uMaxLatency = uMaxLatency.load(std::memory_order_relaxed);
+		Statistics.uTotalLatency = uTotalLatency.load(std::memory_order_relaxed);
+		return Statistics;
+	}
+
+	InputLatency& KeybindManager::GetLatency() noexcept { return Latency; }
 }
\ No newline at end of file
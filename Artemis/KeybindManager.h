@@ -1,9 +1,15 @@
 #ifndef __ARTEMIS_KEYBIND_MANAGER_H__
 #define __ARTEMIS_KEYBIND_MANAGER_H__
 
+#include <atomic>
+#include <vector>
+
 #include <Windows.h>
 
 #include "Definitions.h"
+#include "InputLatency.h"
+#include "InputQueue.h"
+#include "KeybindMatcher.h"
 #include "Manager.h"
 
 namespace Artemis {
@@ -126,30 +132,177 @@ namespace Artemis {
 		PlayPause = VK_MEDIA_PLAY_PAUSE
 	};
 
+	/// <summary>
+	/// <para>A key, optionally combined with modifiers, that calls the keybind when it is pressed, released or repeated.</para>
+	/// <para>A keybind fires while at least its modifiers are held. An exclusive keybind only fires while exactly its modifiers are held, and keeps the keybinds after it on the same key from firing. The keybinds of a key are tried from the most modifiers to the fewest, and then by priority.</para>
+	/// </summary>
 	class ARTEMIS_API IKeybind {
 		VirtualKey nKey;
+		KeyModifiers Modifiers;
+		KeybindTrigger Triggers;
 		bool bExclusive;
+		A_I32 nPriority;
 
 	public:
-		constexpr IKeybind(_In_ VirtualKey nKey, _In_ bool bExclusive) noexcept : nKey(nKey), bExclusive(bExclusive) {}
+		struct InvokeContext {
+			KeybindTrigger Trigger;
+		};
+
+		constexpr IKeybind(_In_ VirtualKey nKey, _In_ bool bExclusive, _In_ A_I32 nPriority = 0) noexcept : nKey(nKey), Modifiers(KeyModifiers::None), Triggers(KeybindTrigger::Press), bExclusive(bExclusive), nPriority(nPriority) {}
+
+		constexpr IKeybind(
+			_In_ VirtualKey nKey,
+			_In_ KeyModifiers Modifiers,
+			_In_ bool bExclusive,
+			_In_ A_I32 nPriority = 0,
+			_In_ KeybindTrigger Triggers = KeybindTrigger::Press
+		) noexcept : nKey(nKey), Modifiers(Modifiers), Triggers(Triggers), bExclusive(bExclusive), nPriority(nPriority) {}
+
+		virtual ~IKeybind() = default;
 
 		virtual void OnKeyPress() = 0;
+		virtual void OnKeyRelease() {}
+		virtual void OnKeyRepeat() {}
 
-		void Invoke();
+		bool IsKeyDown() const;
+
+		/// <summary>
+		/// Checks whether the keybind fires while the given modifiers are held.
+		/// </summary>
+		constexpr bool Matches(_In_ KeyModifiers Held) const noexcept { return MatchesModifiers(Modifiers, bExclusive, Held); }
+
+		template<std::derived_from<IKeybind> T>
+		static void InvokeRange(_In_ const InvocableRange<IKeybind>& refRange, _In_ const InvokeContext& refContext) {
+			for (A_U32 i = 0; i < refRange.uCount; i++) {
+				T* pKeybind = static_cast<T*>(refRange.ppObjects[i]);
+				ARTEMIS_TIME_INVOCATION(refRange, i);
+
+				switch (refContext.Trigger) {
+				case KeybindTrigger::Press: pKeybind->OnKeyPress(); break;
+				case KeybindTrigger::Release: pKeybind->OnKeyRelease(); break;
+				case KeybindTrigger::Repeat: pKeybind->OnKeyRepeat(); break;
+				}
+			}
+		}
 
 		constexpr VirtualKey GetKey() const noexcept { return nKey; }
+		constexpr KeyModifiers GetModifiers() const noexcept { return Modifiers; }
+		constexpr KeybindTrigger GetTriggers() const noexcept { return Triggers; }
 		constexpr bool IsExclusive() const noexcept { return bExclusive; }
+		constexpr A_I32 GetPriority() const noexcept { return nPriority; }
 	};
 
-	using KeybindIndex = int;
+	using KeybindHandle = InvocableHandle<IKeybind>;
 
 #ifdef _ARTEMIS_EXPORT
-	extern template class Manager<IKeybind, KeybindIndex>;
+	extern template class Manager<IKeybind>;
 #endif // _ARTEMIS_EXPORT
 
-	class ARTEMIS_API KeybindManager : public Manager<IKeybind, KeybindIndex> {
+	struct KeybindStatistics {
+		A_U64 uTransitions;		// The key transitions taken from the input queue.
+		A_U64 uDropped;			// The key transitions lost to a full input queue.
+		A_U64 uPresses;			// The presses that called a keybind.
+		A_U64 uKeybindCalls;
+		A_U64 uWakeups;
+		A_U64 uBusyTime;		// The time the keybind thread spent handling input, in nanoseconds.
+		A_U64 uIdleTime;		// The time the keybind thread spent blocked in Wait, in nanoseconds.
+		A_U64 uLastLatency;		// The time from posting the last press to calling its first keybind, in nanoseconds.
+		A_U64 uMaxLatency;
+		A_U64 uTotalLatency;	// Summed over every press, for the average.
+	};
+
+	/// <summary>
+	/// <para>Calls keybinds as their keys are pressed, released and repeated.</para>
+	/// <para>Key transitions are posted by the thread that receives window messages, and queued without locking. The keybind thread blocks in Wait until there is input or the keybinds change, then handles it in Invoke.</para>
+	/// <para>Invoke hands the transitions to a KeybindMatcher, which only looks at the keybinds of the keys that changed. Its table of keybinds by key is compiled whenever keybinds are added or released.</para>
+	/// <para>Every keybind call is recorded with the time of its key transition, so its latency can be measured up to the frame that shows it.</para>
+	/// <para>The generic Shift, Control and Alt keys are down while either of their left and right keys is down, so only the side-specific keys need to be posted.</para>
+	/// </summary>
+	class ARTEMIS_API KeybindManager : public Manager<IKeybind> {
+		InputQueue Input;
+
+		// Only touched by the keybind thread.
+		KeybindMatcher Matcher; // Reports the index of each keybind in the compiled snapshot.
+		A_U64 uCompiledEpoch; // The epoch of the snapshot the matcher was compiled from.
+		std::vector<RangeInvoker> Invokers; // The invoker of each keybind in the compiled snapshot.
+
+		InputLatency Latency;
+
+		std::atomic<A_U64> uTransitions;
+		std::atomic<A_U64> uPresses;
+		std::atomic<A_U64> uKeybindCalls;
+		std::atomic<A_U64> uWakeups;
+		std::atomic<A_U64> uBusyTime;
+		std::atomic<A_U64> uIdleTime;
+		std::atomic<A_U64> uLastLatency;
+		std::atomic<A_U64> uMaxLatency;
+		std::atomic<A_U64> uTotalLatency;
+		A_U64 uBusySince; // When the keybind thread last returned from Wait, or 0 before its first wait.
+
+		void Compile(_In_ const Snapshot* pSnapshot);
+		void Call(_In_ const Snapshot* pSnapshot, _In_ const KeybindMatch& refMatch);
+
 	public:
+		KeybindManager();
+
+		// Registering and releasing keybinds wakes the keybind thread, so it compiles the new snapshot and quiesces without waiting for input. Released keybinds are deleted, and Synchronize returns, even while no key is pressed.
+
+		Handle Add(_In_ IKeybind* pKeybind);
+
+		template<std::derived_from<IKeybind> T>
+			requires(!std::is_same_v<T, IKeybind>)
+		Handle Add(_In_ T* pKeybind) {
+			Handle hKeybind = Manager<IKeybind>::Add(pKeybind);
+			Interrupt();
+			return hKeybind;
+		}
+
+		template<std::derived_from<IKeybind> T, class... Args>
+		Handle Emplace(Args&&... args) {
+			Handle hKeybind = Manager<IKeybind>::template Emplace<T>(std::forward<Args>(args)...);
+			Interrupt();
+			return hKeybind;
+		}
+
+		void Release();
+		void Release(_In_ Handle hKeybind);
+
+		/// <summary>
+		/// Gets the current time of the clock that timestamps key transitions, in nanoseconds.
+		/// </summary>
+		static A_U64 GetTimestamp() noexcept;
+
+		/// <summary>
+		/// Posts a key transition. May be called from any thread. Returns false if the transition was dropped, in which case every key is released after the transitions posted before it.
+		/// </summary>
+		bool Post(_In_ A_U32 uKey, _In_ bool bDown) noexcept;
+
+		/// <summary>
+		/// Releases every key, for when input stops being delivered while keys may be held, like when the window loses focus.
+		/// </summary>
+		bool PostReleaseAll() noexcept;
+
+		/// <summary>
+		/// Handles the key transitions posted so far, calling the keybinds they trigger. Only to be called from the keybind thread.
+		/// </summary>
 		void Invoke();
+
+		/// <summary>
+		/// Blocks the keybind thread until a key transition is posted or Interrupt is called.
+		/// </summary>
+		void Wait();
+
+		/// <summary>
+		/// Wakes the keybind thread from Wait.
+		/// </summary>
+		void Interrupt() noexcept;
+
+		KeybindStatistics GetStatistics() const noexcept;
+
+		/// <summary>
+		/// Gets the latencies of the keybind calls, from the key transition to the frame that shows them. The render thread marks the frames with BeginFrame and Present.
+		/// </summary>
+		InputLatency& GetLatency() noexcept;
 	};
 }
 
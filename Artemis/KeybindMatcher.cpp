@@ -0,0 +1,78 @@
+#include "KeybindMatcher.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace Artemis {
+	KeybindMatcher::KeybindMatcher() : szuTimestamps() {}
+
+	void KeybindMatcher::Clear() noexcept {
+		for (std::vector<Chord>& refChords : szChords)
+			refChords.clear();
+	}
+
+	void KeybindMatcher::Add(_In_ A_U32 uBinding, _In_ A_U32 uKey, _In_ KeyModifiers Modifiers, _In_ KeybindTrigger Triggers, _In_ bool bExclusive) {
+		szChords[uKey & 0xFF].push_back({ uBinding, Modifiers, Triggers, bExclusive, std::popcount(static_cast<A_U32>(Modifiers)) });
+	}
+
+	void KeybindMatcher::Compile() {
+		// A stable sort keeps the order the chords were added in among chords with as many modifiers.
+		for (std::vector<Chord>& refChords : szChords) {
+			std::stable_sort(refChords.begin(), refChords.end(), [](const Chord& refLeft, const Chord& refRight) { return refLeft.nModifierCount > refRight.nModifierCount; });
+		}
+	}
+
+	void KeybindMatcher::Match(_In_ A_U32 uKey, _In_ KeybindTrigger Trigger, _In_ KeyModifiers Held) {
+		// A modifier that triggers a chord is not one of its modifiers.
+		Held = Held & ~KeyboardState::GetModifierOfKey(uKey);
+
+		for (const Chord& refChord : szChords[uKey]) {
+			if (!(refChord.Triggers & Trigger) || !MatchesModifiers(refChord.Modifiers, refChord.bExclusive, Held)) continue;
+
+			Matches.push_back({ refChord.uBinding, uKey, Trigger, szuTimestamps[uKey] });
+			if (refChord.bExclusive) break;
+		}
+	}
+
+	void KeybindMatcher::Commit() {
+		KeyboardEdges Edges = Keyboard.Commit();
+		KeyModifiers Held = Keyboard.GetModifiers();
+
+		Edges.Pressed.ForEach([&](A_U32 uKey) { Match(uKey, KeybindTrigger::Press, Held); });
+		Edges.Repeated.ForEach([&](A_U32 uKey) { Match(uKey, KeybindTrigger::Repeat, Held); });
+		Edges.Released.ForEach([&](A_U32 uKey) { Match(uKey, KeybindTrigger::Release, Held); });
+	}
+
+	void KeybindMatcher::Apply(_In_ const InputEvent& refEvent) {
+		if (refEvent.uKey == InputQueue::c_uAllKeys) {
+			Flush();
+			Keyboard.ReleaseAll();
+
+			for (A_U64& refTimestamp : szuTimestamps)
+				refTimestamp = refEvent.uTimestamp;
+			return;
+		}
+
+		A_U32 uKey = refEvent.uKey & 0xFF;
+
+		if (Keyboard.IsTouched(uKey) || (KeyboardState::GetModifierOfKey(uKey) != KeyModifiers::None && Keyboard.IsTouched()))
+			Commit();
+
+		Keyboard.Apply(uKey, refEvent.bDown);
+
+		szuTimestamps[uKey] = refEvent.uTimestamp;
+		if (A_U32 uGenericKey = KeyboardState::GetGenericKey(uKey))
+			szuTimestamps[uGenericKey] = refEvent.uTimestamp;
+	}
+
+	void KeybindMatcher::Flush() {
+		if (Keyboard.IsTouched())
+			Commit();
+	}
+
+	const std::vector<KeybindMatch>& KeybindMatcher::GetMatches() const noexcept { return Matches; }
+
+	void KeybindMatcher::ClearMatches() noexcept { Matches.clear(); }
+
+	const KeyboardState& KeybindMatcher::GetKeyboard() const noexcept { return Keyboard; }
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#ifndef __ARTEMIS_KEYBIND_MATCHER_H__
+#define __ARTEMIS_KEYBIND_MATCHER_H__
+
+#include <vector>
+
+#include <Aurora/Definitions.h>
+
+#include "Definitions.h"
+#include "InputQueue.h"
+#include "KeyboardState.h"
+
+namespace Artemis {
+	enum class KeybindTrigger : A_U32 {
+		Press = 1 << 0,
+		Release = 1 << 1,
+		Repeat = 1 << 2	// The key is pressed again while already down, like by the key repeat of the OS.
+	};
+
+	constexpr KeybindTrigger operator|(_In_ KeybindTrigger Left, _In_ KeybindTrigger Right) noexcept { return static_cast<KeybindTrigger>(static_cast<A_U32>(Left) | static_cast<A_U32>(Right)); }
+	constexpr bool operator&(_In_ KeybindTrigger Left, _In_ KeybindTrigger Right) noexcept { return static_cast<A_U32>(Left) & static_cast<A_U32>(Right); }
+
+	/// <summary>
+	/// Checks whether a chord with the given modifiers fires while the held modifiers are down. An exclusive chord only fires while exactly its modifiers are held.
+	/// </summary>
+	constexpr bool MatchesModifiers(_In_ KeyModifiers Modifiers, _In_ bool bExclusive, _In_ KeyModifiers Held) noexcept { return bExclusive ? Held == Modifiers : (Held & Modifiers) == Modifiers; }
+
+	struct KeybindMatch {
+		A_U32 uBinding;			// The binding the chord was added with.
+		A_U32 uKey;
+		KeybindTrigger Trigger;
+		A_U64 uTimestamp;		// The time of the transition that triggered it.
+	};
+
+	/// <summary>
+	/// <para>Matches key transitions against a table of chords, each a key combined with modifiers, keyed by the key that triggers them.</para>
+	/// <para>Apply adds transitions to a snapshot of the keyboard, which is committed before a key changes twice and before a modifier changes, so quick taps are not lost and keys see the modifiers that were held when they changed. Committing yields the keys that changed, and only the chords of those keys are looked at.</para>
+	/// <para>The chords of a key are tried from the most modifiers to the fewest, and then in the order they were added in. A firing exclusive chord keeps the chords after it from firing.</para>
+	/// <para>Only to be used from one thread at a time.</para>
+	/// </summary>
+	class ARTEMIS_API KeybindMatcher {
+		struct Chord {
+			A_U32 uBinding;
+			KeyModifiers Modifiers;
+			KeybindTrigger Triggers;
+			bool bExclusive;
+			A_I32 nModifierCount;
+		};
+
+		KeyboardState Keyboard;
+		A_U64 szuTimestamps[256]; // The time of the last transition of each key.
+		std::vector<Chord> szChords[256];
+		std::vector<KeybindMatch> Matches;
+
+		void Commit();
+		void Match(_In_ A_U32 uKey, _In_ KeybindTrigger Trigger, _In_ KeyModifiers Held);
+
+	public:
+		KeybindMatcher();
+
+		KeybindMatcher(const KeybindMatcher&) = delete;
+		KeybindMatcher& operator=(const KeybindMatcher&) = delete;
+
+		/// <summary>
+		/// Removes every chord. The state of the keyboard is kept.
+		/// </summary>
+		void Clear() noexcept;
+
+		/// <summary>
+		/// Adds a chord. Chords with as many modifiers are tried in the order they are added in. Compile must be called once the chords have been added.
+		/// </summary>
+		/// <param name="uBinding">- The value the matches of the chord are reported with.</param>
+		void Add(_In_ A_U32 uBinding, _In_ A_U32 uKey, _In_ KeyModifiers Modifiers, _In_ KeybindTrigger Triggers, _In_ bool bExclusive);
+
+		/// <summary>
+		/// Orders the chords of every key from the most modifiers to the fewest.
+		/// </summary>
+		void Compile();
+
+		/// <summary>
+		/// Applies a key transition, or releases every key if its key is InputQueue::c_uAllKeys.
+		/// </summary>
+		void Apply(_In_ const InputEvent& refEvent);
+
+		/// <summary>
+		/// Commits the transitions applied since the last commit, so their matches are reported.
+		/// </summary>
+		void Flush();
+
+		/// <summary>
+		/// Gets the chords that fired since ClearMatches was last called, in the order they fired in.
+		/// </summary>
+		const std::vector<KeybindMatch>& GetMatches() const noexcept;
+
+		void ClearMatches() noexcept;
+
+		const KeyboardState& GetKeyboard() const noexcept;
+	};
+}
+
+#endif // !__ARTEMIS_KEYBIND_MATCHER_H__
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "KeyboardState.h"
+
+namespace Artemis {
+	namespace {
+		// The virtual key codes of the modifier keys, VK_SHIFT through VK_RMENU, so the keyboard state builds without the Windows headers.
+		constexpr A_U32 c_uShift = 0x10;
+		constexpr A_U32 c_uControl = 0x11;
+		constexpr A_U32 c_uAlt = 0x12;
+		constexpr A_U32 c_uLeftWindows = 0x5B;
+		constexpr A_U32 c_uRightWindows = 0x5C;
+		constexpr A_U32 c_uLeftShift = 0xA0;
+		constexpr A_U32 c_uRightShift = 0xA1;
+		constexpr A_U32 c_uLeftControl = 0xA2;
+		constexpr A_U32 c_uRightControl = 0xA3;
+		constexpr A_U32 c_uLeftAlt = 0xA4;
+		constexpr A_U32 c_uRightAlt = 0xA5;
+
+		constexpr A_U32 GetOtherSide(_In_ A_U32 uKey) noexcept {
+			switch (uKey) {
+			case c_uLeftShift: return c_uRightShift;
+			case c_uRightShift: return c_uLeftShift;
+			case c_uLeftControl: return c_uRightControl;
+			case c_uRightControl: return c_uLeftControl;
+			case c_uLeftAlt: return c_uRightAlt;
+			case c_uRightAlt: return c_uLeftAlt;
+			default: return 0;
+			}
+		}
+	}
+
+	bool KeyboardState::IsTouched(_In_ A_U32 uKey) const noexcept {
+		KeySet Touched = (Previous ^ Current) | Repeated;
+
+		A_U32 uGenericKey = GetGenericKey(uKey);
+		return Touched.Test(uKey) || (uGenericKey && Touched.Test(uGenericKey));
+	}
+
+	bool KeyboardState::IsTouched() const noexcept { return !((Previous ^ Current) | Repeated).IsEmpty(); }
+
+	void KeyboardState::Apply(_In_ A_U32 uKey, _In_ bool bDown) noexcept {
+		if (bDown && Current.Test(uKey)) {
+			Repeated.Set(uKey);
+			return;
+		}
+
+		Current.Assign(uKey, bDown);
+
+		A_U32 uGenericKey = GetGenericKey(uKey);
+		if (uGenericKey)
+			Current.Assign(uGenericKey, bDown || Current.Test(GetOtherSide(uKey)));
+	}
+
+	void KeyboardState::ReleaseAll() noexcept { Current = KeySet(); }
+
+	KeyboardEdges KeyboardState::Commit() noexcept {
+		KeySet Changed = Previous ^ Current;
+
+		KeyboardEdges Edges;
+		Edges.Pressed = Changed & Current;
+		Edges.Released = Changed & Previous;
+		Edges.Repeated = Repeated;
+
+		Previous = Current;
+		Repeated = KeySet();
+		return Edges;
+	}
+
+	KeyModifiers KeyboardState::GetModifiers() const noexcept {
+		KeyModifiers Modifiers = KeyModifiers::None;
+		if (Current.Test(c_uControl)) Modifiers = Modifiers | KeyModifiers::Control;
+		if (Current.Test(c_uShift)) Modifiers = Modifiers | KeyModifiers::Shift;
+		if (Current.Test(c_uAlt)) Modifiers = Modifiers | KeyModifiers::Alt;
+		if (Current.Test(c_uLeftWindows) || Current.Test(c_uRightWindows)) Modifiers = Modifiers | KeyModifiers::Windows;
+		return Modifiers;
+	}
+
+	A_U32 KeyboardState::GetGenericKey(_In_ A_U32 uKey) noexcept {
+		switch (uKey) {
+		case c_uLeftShift: case c_uRightShift: return c_uShift;
+		case c_uLeftControl: case c_uRightControl: return c_uControl;
+		case c_uLeftAlt: case c_uRightAlt: return c_uAlt;
+		default: return 0;
+		}
+	}
+
+	KeyModifiers KeyboardState::GetModifierOfKey(_In_ A_U32 uKey) noexcept {
+		switch (uKey) {
+		case c_uControl: case c_uLeftControl: case c_uRightControl: return KeyModifiers::Control;
+		case c_uShift: case c_uLeftShift: case c_uRightShift: return KeyModifiers::Shift;
+		case c_uAlt: case c_uLeftAlt: case c_uRightAlt: return KeyModifiers::Alt;
+		case c_uLeftWindows: case c_uRightWindows: return KeyModifiers::Windows;
+		default: return KeyModifiers::None;
+		}
+	}
+}
\ No newline at end of file
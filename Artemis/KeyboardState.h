@@ -0,0 +1,127 @@
+#ifndef __ARTEMIS_KEYBOARD_STATE_H__
+#define __ARTEMIS_KEYBOARD_STATE_H__
+
+#include <bit>
+
+#include <Aurora/Definitions.h>
+
+#include "Definitions.h"
+
+namespace Artemis {
+	enum class KeyModifiers : A_U32 {
+		None = 0,
+		Control = 1 << 0,
+		Shift = 1 << 1,
+		Alt = 1 << 2,
+		Windows = 1 << 3
+	};
+
+	constexpr KeyModifiers operator|(_In_ KeyModifiers Left, _In_ KeyModifiers Right) noexcept { return static_cast<KeyModifiers>(static_cast<A_U32>(Left) | static_cast<A_U32>(Right)); }
+	constexpr KeyModifiers operator&(_In_ KeyModifiers Left, _In_ KeyModifiers Right) noexcept { return static_cast<KeyModifiers>(static_cast<A_U32>(Left) & static_cast<A_U32>(Right)); }
+	constexpr KeyModifiers operator~(_In_ KeyModifiers Modifiers) noexcept { return static_cast<KeyModifiers>(~static_cast<A_U32>(Modifiers) & 0xF); }
+
+	/// <summary>
+	/// A set of virtual keys, stored as a 256-bit bitset.
+	/// </summary>
+	struct KeySet {
+		static constexpr A_U32 c_uWordCount = 4;
+
+		A_U64 szuWords[c_uWordCount];
+
+		constexpr KeySet() noexcept : szuWords() {}
+
+		constexpr bool Test(_In_ A_U32 uKey) const noexcept { return szuWords[(uKey >> 6) & 3] >> (uKey & 63) & 1; }
+		constexpr void Set(_In_ A_U32 uKey) noexcept { szuWords[(uKey >> 6) & 3] |= 1ULL << (uKey & 63); }
+		constexpr void Reset(_In_ A_U32 uKey) noexcept { szuWords[(uKey >> 6) & 3] &= ~(1ULL << (uKey & 63)); }
+		constexpr void Assign(_In_ A_U32 uKey, _In_ bool bValue) noexcept { bValue ? Set(uKey) : Reset(uKey); }
+
+		constexpr bool IsEmpty() const noexcept { return !(szuWords[0] | szuWords[1] | szuWords[2] | szuWords[3]); }
+
+		constexpr KeySet operator^(_In_ const KeySet& refOther) const noexcept {
+			KeySet Result;
+			for (A_U32 i = 0; i < c_uWordCount; i++) Result.szuWords[i] = szuWords[i] ^ refOther.szuWords[i];
+			return Result;
+		}
+
+		constexpr KeySet operator&(_In_ const KeySet& refOther) const noexcept {
+			KeySet Result;
+			for (A_U32 i = 0; i < c_uWordCount; i++) Result.szuWords[i] = szuWords[i] & refOther.szuWords[i];
+			return Result;
+		}
+
+		constexpr KeySet operator|(_In_ const KeySet& refOther) const noexcept {
+			KeySet Result;
+			for (A_U32 i = 0; i < c_uWordCount; i++) Result.szuWords[i] = szuWords[i] | refOther.szuWords[i];
+			return Result;
+		}
+
+		/// <summary>
+		/// Calls fnCallback with every key in the set, in ascending order. Only the keys in the set are visited.
+		/// </summary>
+		template<class Callback>
+		void ForEach(_In_ Callback&& fnCallback) const {
+			for (A_U32 i = 0; i < c_uWordCount; i++)
+				for (A_U64 uWord = szuWords[i]; uWord; uWord &= uWord - 1)
+					fnCallback(i * 64 + static_cast<A_U32>(std::countr_zero(uWord)));
+		}
+	};
+
+	struct KeyboardEdges {
+		KeySet Pressed;
+		KeySet Released;
+		KeySet Repeated; // Keys that were pressed again while already down, like by the key repeat of the OS.
+	};
+
+	/// <summary>
+	/// <para>The state of every key, and the changes to it since it was last committed.</para>
+	/// <para>Transitions are applied to the current snapshot. Committing compares it with the previous snapshot a word at a time, so finding the keys that changed costs the same however many keys are bound.</para>
+	/// <para>A snapshot can only hold one change per key. Before applying a transition to a key that has already changed since the last commit, commit first, so quick taps are not lost.</para>
+	/// <para>The generic Shift, Control and Alt keys follow their left and right keys, and are down while either side is down.</para>
+	/// </summary>
+	class ARTEMIS_API KeyboardState {
+		KeySet Previous;
+		KeySet Current;
+		KeySet Repeated;
+
+	public:
+		constexpr KeyboardState() noexcept {}
+
+		/// <summary>
+		/// Checks whether a transition of the key, or of its generic key, has been applied since the last commit.
+		/// </summary>
+		bool IsTouched(_In_ A_U32 uKey) const noexcept;
+
+		/// <summary>
+		/// Checks whether anything has been applied since the last commit.
+		/// </summary>
+		bool IsTouched() const noexcept;
+
+		void Apply(_In_ A_U32 uKey, _In_ bool bDown) noexcept;
+
+		void ReleaseAll() noexcept;
+
+		/// <summary>
+		/// Gets the keys that were pressed, released and repeated since the last commit, and starts a new snapshot.
+		/// </summary>
+		KeyboardEdges Commit() noexcept;
+
+		constexpr bool IsDown(_In_ A_U32 uKey) const noexcept { return Current.Test(uKey); }
+
+		/// <summary>
+		/// Gets the modifiers that are down.
+		/// </summary>
+		KeyModifiers GetModifiers() const noexcept;
+
+		/// <summary>
+		/// Gets the generic key of a left or right Shift, Control or Alt key, or 0 if the key has none.
+		/// </summary>
+		static A_U32 GetGenericKey(_In_ A_U32 uKey) noexcept;
+
+		/// <summary>
+		/// Gets the modifier a key belongs to, or KeyModifiers::None if it is not a modifier key.
+		/// </summary>
+		static KeyModifiers GetModifierOfKey(_In_ A_U32 uKey) noexcept;
+	};
+}
+
+#endif // !__ARTEMIS_KEYBOARD_STATE_H__
\ No newline at end of file
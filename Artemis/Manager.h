@@ -1,32 +1,257 @@
 #ifndef __ARTEMIS_MANAGER_H__
 #define __ARTEMIS_MANAGER_H__
 
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <map>
+#include <new>
+#include <mutex>
+#include <set>
 #include <type_traits>
+#include <vector>
+
+#include <Aurora/Definitions.h>
 
 #include "Definitions.h"
+#include "FrameArena.h"
+#include "ObjectPool.h"
+#include "Profiler.h"
 
 namespace Artemis {
 	template<class T>
 	concept AbstractClass = std::is_abstract<T>::value;
 
-	template<class T>
-	concept Int32 = std::is_same<T, int>::value;
+	/// <summary>
+	/// A generation tagged handle to an object registered in a manager.
+	/// A handle becomes stale once the object it refers to is released, even if its slot is reused.
+	/// </summary>
+	/// <typeparam name="IInvocable">- The interface of the manager that issued the handle.</typeparam>
+	template<AbstractClass IInvocable>
+	struct InvocableHandle {
+		A_U32 uSlot;
+		A_U32 uGeneration;
+
+		constexpr InvocableHandle() noexcept : uSlot(INVALID_SLOT), uGeneration(0) {}
+		constexpr InvocableHandle(_In_ A_U32 uSlot, _In_ A_U32 uGeneration) noexcept : uSlot(uSlot), uGeneration(uGeneration) {}
+
+		constexpr bool IsValid() const noexcept { return uSlot != INVALID_SLOT; }
+
+		constexpr bool operator==(const InvocableHandle&) const noexcept = default;
+	};
+
+	/// <summary>
+	/// A run of objects of the same concrete type, passed to IInvocable::InvokeRange.
+	/// Unconstrained, since it is named inside the interfaces while they are still incomplete.
+	/// </summary>
+	template<class IInvocable>
+	struct InvocableRange {
+		IInvocable* const* ppObjects;
+#ifdef ARTEMIS_PROFILE
+		InvocableTimings* const* ppTimings;
+#endif // ARTEMIS_PROFILE
+		A_U32 uCount;
+	};
 
-	template<AbstractClass IInvocable, Int32 InvocableIndex>
+	/// <summary>
+	/// <para>A registry of invocable objects that is safe to modify while it is being invoked.</para>
+	/// <para>Add and Release may be called from any thread. They modify a private collection and publish an immutable snapshot of it.</para>
+	/// <para>The invoking thread reads the latest snapshot without locking and must call Quiesce once it holds no references into it, typically at the end of a frame.</para>
+	/// <para>Released objects and superseded snapshots are only deleted once the invoking thread has quiesced past the point where they were unpublished. Quiesce deletes them as soon as that is the case, unless a writer holds the registry at that moment, and Synchronize waits for it.</para>
+	/// <para>Objects are invoked in ascending order of phase (IInvocable::GetPhase, if the interface has phases) and then priority (IInvocable::GetPriority).</para>
+	/// <para>Objects with equal keys are invoked in runs grouped by their concrete type, in the order the types were first registered in, and each run in registration order. Each run is handled by IInvocable::InvokeRange&lt;T&gt;, which calls through a T*, so the calls are resolved statically whenever T or its overrides are final.</para>
+	/// <para>Every Add and Release rebuilds the snapshot, so it costs time linear in the number of registered objects. Registration is meant to happen far less often than invocation.</para>
+	/// <para>Objects created with Emplace live in a pool owned by the manager instead of on the process heap.</para>
+	/// </summary>
+	/// <typeparam name="IInvocable">- The interface of the objects to manage.</typeparam>
+	template<AbstractClass IInvocable>
 	class Manager {
+	public:
+		using Handle = InvocableHandle<IInvocable>;
+		using InvokeContext = typename IInvocable::InvokeContext;
+		using Range = InvocableRange<IInvocable>;
+		using RangeInvoker = void(*)(_In_ const Range& refRange, _In_ const InvokeContext& refContext);
+
 	protected:
-		IInvocable* InvocableCollection[MAX_INVOKE];
+		struct Run {
+			RangeInvoker pfnInvoke;
+			A_U32 uPhase;
+			A_U32 uBegin;
+			A_U32 uCount;
+		};
+
+		struct Snapshot {
+			A_U64 uEpoch;
+			std::vector<IInvocable*> Objects; // Every live object, sorted by phase and priority, and grouped by concrete type within equal keys.
+#ifdef ARTEMIS_PROFILE
+			std::vector<InvocableTimings*> Timings; // The timings of every object in Objects.
+#endif // ARTEMIS_PROFILE
+			std::vector<Run> Runs;
+		};
+
+	private:
+		// Destroys an object created by Emplace and returns its cell to the pool.
+		using Deleter = void(*)(_Inout_ ObjectPool& refPool, _In_ IInvocable* pObject) noexcept;
+
+		template<std::derived_from<IInvocable> T>
+		static void DestroyPooled(_Inout_ ObjectPool& refPool, _In_ IInvocable* pObject) noexcept {
+			T* pTyped = static_cast<T*>(pObject);
+			pTyped->~T();
+			refPool.Free(pTyped, sizeof(T), alignof(T));
+		}
+
+		struct Slot {
+			IInvocable* pObject; // The registered object, or null if the slot is unused.
+			RangeInvoker pfnInvoke;
+			Deleter pfnDestroy; // Null if the object was allocated with new.
+			A_U64 uKey;
+			A_U64 uTypeSequence;
+			A_U64 uSequence;
+			A_U32 uGeneration;
+			A_U32 uNextFree;
+#ifdef ARTEMIS_PROFILE
+			InvocableTimings* pTimings;
+#endif // ARTEMIS_PROFILE
+		};
+
+		// Orders the registered objects by key, then by the first registration of their invoker so that equal keys form runs, then by registration order.
+		struct OrderEntry {
+			A_U64 uKey;
+			A_U64 uTypeSequence;
+			A_U64 uSequence;
+			A_U32 uSlot;
+
+			bool operator<(const OrderEntry& refOther) const noexcept {
+				if (uKey != refOther.uKey) return uKey < refOther.uKey;
+				if (uTypeSequence != refOther.uTypeSequence) return uTypeSequence < refOther.uTypeSequence;
+				return uSequence < refOther.uSequence;
+			}
+		};
+
+		struct Retired {
+			A_U64 uEpoch;
+			const Snapshot* pSnapshot;
+			IInvocable* pObject;
+			Deleter pfnDestroy;
+#ifdef ARTEMIS_PROFILE
+			InvocableTimings* pTimings;
+#endif // ARTEMIS_PROFILE
+		};
+
+		std::mutex WriterLock;
+
+		std::vector<Slot> Slots;
+		std::set<OrderEntry> Order;
+		std::map<RangeInvoker, A_U64> TypeSequences; // The sequence number of the first registration of every invoker.
+		A_U32 uFreeSlot;
+		A_U64 uNextSequence;
+
+		ObjectPool Pool;
+
+		std::vector<Retired> RetiredCollection;
+
+		std::atomic<const Snapshot*> pPublished;
+		std::atomic<A_U64> uQuiescentEpoch;
+		std::atomic<bool> bReclaimPending; // Set while RetiredCollection is not empty, so Quiesce only takes the writer lock when there is something to delete.
+
+		void Destroy(_In_ const Retired& refRetired) noexcept;
+		static A_U64 SortKey(_In_ const IInvocable* pObject) noexcept;
+
+		Handle Insert(_In_ IInvocable* pObject, _In_ RangeInvoker pfnInvoke, _In_opt_ Deleter pfnDestroy);
+		void Publish(_In_ const Retired& refReleased);
+		Retired Unregister(_In_ Slot& refSlot);
+		void Retire(_In_ const Retired& refRetired, _In_ A_U64 uEpoch);
+		void Reclaim() noexcept;
+
+	protected:
+		/// <summary>
+		/// Gets the latest published snapshot. Only to be called from the invoking thread.
+		/// The snapshot stays valid until the next call to Quiesce.
+		/// </summary>
+		const std::vector<IInvocable*>& Acquire() const noexcept;
+
+		/// <summary>
+		/// Gets the latest published snapshot, with its runs. Only to be called from the invoking thread.
+		/// The snapshot stays valid until the next call to Quiesce.
+		/// </summary>
+		const Snapshot* AcquireSnapshot() const noexcept;
+
+		/// <summary>
+		/// Invokes every object in the latest published snapshot. Only to be called from the invoking thread.
+		/// </summary>
+		/// <param name="pPhaseContexts">- An array of contexts indexed by phase. Every run receives the context of its phase.</param>
+		void InvokeAll(_In_ const InvokeContext* pPhaseContexts) const;
 
 	public:
 		Manager();
 		~Manager();
 
-		InvocableIndex Add(_In_ IInvocable* pObject);
+		Manager(const Manager&) = delete;
+		Manager& operator=(const Manager&) = delete;
+
+		/// <summary>
+		/// Takes ownership of a heap allocated object. The object is invoked through its virtual interface.
+		/// </summary>
+		Handle Add(_In_ IInvocable* pObject);
+
+		/// <summary>
+		/// Takes ownership of a heap allocated object. The object is grouped with other objects added as a T.
+		/// </summary>
+		template<std::derived_from<IInvocable> T>
+			requires(!std::is_same_v<T, IInvocable>)
+		Handle Add(_In_ T* pObject) {
+			if (!pObject) return Handle();
+
+			std::lock_guard<std::mutex> Lock(WriterLock);
+			return Insert(pObject, &IInvocable::template InvokeRange<T>, nullptr);
+		}
+
+		/// <summary>
+		/// Constructs an object in the pool of the manager. The object is grouped with other objects of type T.
+		/// </summary>
+		template<std::derived_from<IInvocable> T, class... Args>
+		Handle Emplace(Args&&... args) {
+			std::lock_guard<std::mutex> Lock(WriterLock);
+
+			A_LPVOID lpCell = Pool.Allocate(sizeof(T), alignof(T));
+
+			T* pObject;
+			try {
+				pObject = new(lpCell) T(std::forward<Args>(args)...);
+			}
+			catch (...) {
+				Pool.Free(lpCell, sizeof(T), alignof(T));
+				throw;
+			}
+
+			return Insert(pObject, &IInvocable::template InvokeRange<T>, &DestroyPooled<T>);
+		}
+
+		void Release();
+		void Release(_In_ Handle hObject);
+
+		_Ret_maybenull_ IInvocable* Get(_In_ Handle hObject);
+
+		A_U32 Count() const noexcept;
+
+		/// <summary>
+		/// Declares that the invoking thread no longer references anything it has acquired so far, and deletes what that makes unreachable.
+		/// </summary>
+		void Quiesce() noexcept;
 
-		void Release(_In_range_(INVALID_INDEX, MAX_INVOKE) InvocableIndex nIndex = INVALID_INDEX);
+		/// <summary>
+		/// Waits until the invoking thread has quiesced past every release made so far, and deletes the released objects.
+		/// Call it before unloading the code of released objects. Must not be called from the invoking thread, and only returns once it quiesces again.
+		/// </summary>
+		void Synchronize();
 
-		_Ret_maybenull_ IInvocable* Get(_In_range_(0, MAX_INVOKE) InvocableIndex nIndex);
+#ifdef ARTEMIS_PROFILE
+		/// <summary>
+		/// Appends the call timings of every registered object to a list of reports.
+		/// </summary>
+		void QueryTimings(_Inout_ std::vector<TimingReport>& refReports);
+#endif // ARTEMIS_PROFILE
 	};
 }
 
-#endif // !__ARTEMIS_MANAGER_H__
\ No newline at end of file
+#endif // !__ARTEMIS_MANAGER_H__
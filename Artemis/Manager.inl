@@ -0,0 +1,277 @@
+#ifndef __ARTEMIS_MANAGER_INL__
+#define __ARTEMIS_MANAGER_INL__
+
+// The members of Manager, for Manager.cpp to instantiate the managers of the DLL, and for anything else that instantiates a manager of its own.
+
+#include <chrono>
+#include <thread>
+#include <typeinfo>
+
+#include "Manager.h"
+
+namespace Artemis {
+	template<AbstractClass IInvocable>
+	Manager<IInvocable>::Manager() : uFreeSlot(INVALID_SLOT), uNextSequence(0), pPublished(new Snapshot()), uQuiescentEpoch(0), bReclaimPending(false) {}
+
+	template<AbstractClass IInvocable>
+	Manager<IInvocable>::~Manager() {
+		// No thread can be invoking the manager anymore, so everything can be deleted right away.
+		for (Slot& refSlot : Slots)
+			if (refSlot.pObject)
+				Destroy(Unregister(refSlot));
+
+		for (const Retired& refRetired : RetiredCollection)
+			Destroy(refRetired);
+
+		delete pPublished.load();
+	}
+
+	template<AbstractClass IInvocable>
+	void Manager<IInvocable>::Destroy(_In_ const Retired& refRetired) noexcept {
+		delete refRetired.pSnapshot;
+
+		if (refRetired.pObject) {
+			if (refRetired.pfnDestroy) refRetired.pfnDestroy(Pool, refRetired.pObject);
+			else delete refRetired.pObject;
+		}
+
+#ifdef ARTEMIS_PROFILE
+		delete refRetired.pTimings;
+#endif // ARTEMIS_PROFILE
+	}
+
+	template<AbstractClass IInvocable>
+	A_U64 Manager<IInvocable>::SortKey(_In_ const IInvocable* pObject) noexcept {
+		A_U64 uPhase = 0;
+		if constexpr (requires { pObject->GetPhase(); })
+			uPhase = pObject->GetPhase();
+
+		// Flip the sign bit so that signed priorities order correctly as unsigned integers.
+		return (uPhase << 32) | (static_cast<A_U32>(pObject->GetPriority()) ^ 0x80000000U);
+	}
+
+	template<AbstractClass IInvocable>
+	typename Manager<IInvocable>::Handle Manager<IInvocable>::Insert(_In_ IInvocable* pObject, _In_ RangeInvoker pfnInvoke, _In_opt_ Deleter pfnDestroy) {
+		A_U32 uSlot;
+		if (uFreeSlot != INVALID_SLOT) {
+			uSlot = uFreeSlot;
+			uFreeSlot = Slots[uSlot].uNextFree;
+		}
+		else {
+			uSlot = static_cast<A_U32>(Slots.size());
+			Slots.emplace_back();
+			Slots.back().uGeneration = 0;
+		}
+
+		Slot& refSlot = Slots[uSlot];
+		refSlot.pObject = pObject;
+		refSlot.pfnInvoke = pfnInvoke;
+		refSlot.pfnDestroy = pfnDestroy;
+		refSlot.uKey = SortKey(pObject);
+		refSlot.uSequence = uNextSequence++;
+		refSlot.uTypeSequence = TypeSequences.try_emplace(pfnInvoke, refSlot.uSequence).first->second;
+		refSlot.uNextFree = INVALID_SLOT;
+#ifdef ARTEMIS_PROFILE
+		refSlot.pTimings = new InvocableTimings();
+#endif // ARTEMIS_PROFILE
+
+		Order.insert({ refSlot.uKey, refSlot.uTypeSequence, refSlot.uSequence, uSlot });
+
+		Publish({});
+
+		return Handle(uSlot, refSlot.uGeneration);
+	}
+
+	template<AbstractClass IInvocable>
+	typename Manager<IInvocable>::Retired Manager<IInvocable>::Unregister(_In_ Slot& refSlot) {
+		Retired Released = {};
+		Released.pObject = refSlot.pObject;
+		Released.pfnDestroy = refSlot.pfnDestroy;
+#ifdef ARTEMIS_PROFILE
+		Released.pTimings = refSlot.pTimings;
+		refSlot.pTimings = nullptr;
+#endif // ARTEMIS_PROFILE
+
+		refSlot.pObject = nullptr;
+		refSlot.pfnDestroy = nullptr;
+		refSlot.uGeneration++;
+		return Released;
+	}
+
+	template<AbstractClass IInvocable>
+	void Manager<IInvocable>::Publish(_In_ const Retired& refReleased) {
+		const Snapshot* pPrevious = pPublished.load();
+		Snapshot* pNext = new Snapshot();
+		pNext->uEpoch = pPrevious->uEpoch + 1;
+
+		pNext->Objects.reserve(Order.size());
+#ifdef ARTEMIS_PROFILE
+		pNext->Timings.reserve(Order.size());
+#endif // ARTEMIS_PROFILE
+
+		for (const OrderEntry& refEntry : Order) {
+			const Slot& refSlot = Slots[refEntry.uSlot];
+			A_U32 uPhase = static_cast<A_U32>(refEntry.uKey >> 32);
+
+			if (pNext->Runs.empty() || pNext->Runs.back().pfnInvoke != refSlot.pfnInvoke || pNext->Runs.back().uPhase != uPhase)
+				pNext->Runs.push_back({ refSlot.pfnInvoke, uPhase, static_cast<A_U32>(pNext->Objects.size()), 0 });
+
+			pNext->Objects.push_back(refSlot.pObject);
+#ifdef ARTEMIS_PROFILE
+			pNext->Timings.push_back(refSlot.pTimings);
+#endif // ARTEMIS_PROFILE
+			pNext->Runs.back().uCount++;
+		}
+
+		pPublished.store(pNext);
+
+		Retired Superseded = refReleased;
+		Superseded.pSnapshot = pPrevious;
+		Retire(Superseded, pNext->uEpoch);
+
+		Reclaim();
+	}
+
+	template<AbstractClass IInvocable>
+	void Manager<IInvocable>::Retire(_In_ const Retired& refRetired, _In_ A_U64 uEpoch) {
+		RetiredCollection.push_back(refRetired);
+		RetiredCollection.back().uEpoch = uEpoch;
+		bReclaimPending.store(true);
+	}
+
+	template<AbstractClass IInvocable>
+	void Manager<IInvocable>::Reclaim() noexcept {
+		A_U64 uEpoch = uQuiescentEpoch.load();
+
+		std::erase_if(RetiredCollection, [this, uEpoch](const Retired& refRetired) {
+			if (refRetired.uEpoch > uEpoch) return false;
+
+			Destroy(refRetired);
+			return true;
+		});
+
+		bReclaimPending.store(!RetiredCollection.empty());
+	}
+
+	template<AbstractClass IInvocable>
+	const std::vector<IInvocable*>& Manager<IInvocable>::Acquire() const noexcept { return pPublished.load()->Objects; }
+
+	template<AbstractClass IInvocable>
+	const typename Manager<IInvocable>::Snapshot* Manager<IInvocable>::AcquireSnapshot() const noexcept { return pPublished.load(); }
+
+	template<AbstractClass IInvocable>
+	void Manager<IInvocable>::InvokeAll(_In_ const InvokeContext* pPhaseContexts) const {
+		const Snapshot* pSnapshot = pPublished.load();
+
+		for (const Run& refRun : pSnapshot->Runs) {
+			Range InvocationRange;
+			InvocationRange.ppObjects = pSnapshot->Objects.data() + refRun.uBegin;
+#ifdef ARTEMIS_PROFILE
+			InvocationRange.ppTimings = pSnapshot->Timings.data() + refRun.uBegin;
+#endif // ARTEMIS_PROFILE
+			InvocationRange.uCount = refRun.uCount;
+
+			refRun.pfnInvoke(InvocationRange, pPhaseContexts[refRun.uPhase]);
+		}
+	}
+
+	template<AbstractClass IInvocable>
+	typename Manager<IInvocable>::Handle Manager<IInvocable>::Add(_In_ IInvocable* pObject) {
+		if (!pObject) return Handle();
+
+		std::lock_guard<std::mutex> Lock(WriterLock);
+		return Insert(pObject, &IInvocable::template InvokeRange<IInvocable>, nullptr);
+	}
+
+	template<AbstractClass IInvocable>
+	void Manager<IInvocable>::Release() {
+		std::lock_guard<std::mutex> Lock(WriterLock);
+
+		std::vector<Retired> ReleasedObjects;
+		for (Slot& refSlot : Slots)
+			if (refSlot.pObject)
+				ReleasedObjects.push_back(Unregister(refSlot));
+
+		Order.clear();
+
+		// Every generation was bumped when unregistering, or when the slot was last released, so no handle issued before the release stays valid.
+		uFreeSlot = INVALID_SLOT;
+		for (A_U32 i = static_cast<A_U32>(Slots.size()); i-- > 0;) {
+			Slots[i].uNextFree = uFreeSlot;
+			uFreeSlot = i;
+		}
+
+		Publish({});
+
+		// Retired with the epoch of the snapshot that dropped them, so the next quiescent point past it deletes them.
+		A_U64 uEpoch = pPublished.load()->uEpoch;
+		for (const Retired& refRetired : ReleasedObjects)
+			Retire(refRetired, uEpoch);
+	}
+
+	template<AbstractClass IInvocable>
+	void Manager<IInvocable>::Release(_In_ Handle hObject) {
+		std::lock_guard<std::mutex> Lock(WriterLock);
+
+		if (hObject.uSlot >= Slots.size()) return;
+
+		Slot& refSlot = Slots[hObject.uSlot];
+		if (refSlot.uGeneration != hObject.uGeneration || !refSlot.pObject) return;
+
+		Order.erase({ refSlot.uKey, refSlot.uTypeSequence, refSlot.uSequence, hObject.uSlot });
+
+		Retired Released = Unregister(refSlot);
+		refSlot.uNextFree = uFreeSlot;
+		uFreeSlot = hObject.uSlot;
+
+		Publish(Released);
+	}
+
+	template<AbstractClass IInvocable>
+	_Ret_maybenull_ IInvocable* Manager<IInvocable>::Get(_In_ Handle hObject) {
+		std::lock_guard<std::mutex> Lock(WriterLock);
+
+		if (hObject.uSlot >= Slots.size()) return nullptr;
+
+		const Slot& refSlot = Slots[hObject.uSlot];
+		if (refSlot.uGeneration != hObject.uGeneration) return nullptr;
+		return refSlot.pObject;
+	}
+
+	template<AbstractClass IInvocable>
+	A_U32 Manager<IInvocable>::Count() const noexcept { return static_cast<A_U32>(pPublished.load()->Objects.size()); }
+
+	template<AbstractClass IInvocable>
+	void Manager<IInvocable>::Quiesce() noexcept {
+		uQuiescentEpoch.store(pPublished.load()->uEpoch);
+
+		if (!bReclaimPending.load()) return;
+
+		// Never wait for a writer here. A writer reclaims on its own, and whatever it leaves is deleted on the next quiescent point.
+		std::unique_lock<std::mutex> Lock(WriterLock, std::try_to_lock);
+		if (Lock.owns_lock()) Reclaim();
+	}
+
+	template<AbstractClass IInvocable>
+	void Manager<IInvocable>::Synchronize() {
+		A_U64 uEpoch = pPublished.load()->uEpoch;
+		while (uQuiescentEpoch.load() < uEpoch)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		std::lock_guard<std::mutex> Lock(WriterLock);
+		Reclaim();
+	}
+
+#ifdef ARTEMIS_PROFILE
+	template<AbstractClass IInvocable>
+	void Manager<IInvocable>::QueryTimings(_Inout_ std::vector<TimingReport>& refReports) {
+		std::lock_guard<std::mutex> Lock(WriterLock);
+
+		for (const Slot& refSlot : Slots)
+			if (refSlot.pObject)
+				refReports.push_back({ typeid(*refSlot.pObject).name(), refSlot.pTimings->GetStatistics() });
+	}
+#endif // ARTEMIS_PROFILE
+}
+
+#endif // !__ARTEMIS_MANAGER_INL__
\ No newline at end of file
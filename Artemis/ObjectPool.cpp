@@ -0,0 +1,92 @@
+#include "ObjectPool.h"
+
+#include <new>
+
+namespace Artemis {
+	ObjectPool::ObjectPool() noexcept {
+		for (SizeClass& refClass : szClasses) {
+			refClass.pFreeCells = nullptr;
+			refClass.uLiveCells = 0;
+		}
+	}
+
+	ObjectPool::~ObjectPool() {
+		for (SizeClass& refClass : szClasses)
+			FreeBlocks(refClass);
+	}
+
+	A_U32 ObjectPool::GetClassIndex(_In_ A_U64 uSize, _In_ A_U64 uAlignment) noexcept {
+		if (uAlignment > c_uCacheLineSize || !uSize) return INVALID_SLOT;
+
+		A_U64 uIndex = (uSize + c_uCacheLineSize - 1) / c_uCacheLineSize - 1;
+		return uIndex < c_uClassCount ? static_cast<A_U32>(uIndex) : INVALID_SLOT;
+	}
+
+	void ObjectPool::CarveBlock(_Inout_ SizeClass& refClass, _In_ A_BYTE* lpBlock, _In_ A_U64 uCellSize) noexcept {
+		for (A_U64 uOffset = c_uBlockSize - c_uBlockSize % uCellSize; uOffset >= uCellSize;) {
+			uOffset -= uCellSize;
+			FreeCell* pCell = reinterpret_cast<FreeCell*>(lpBlock + uOffset);
+			pCell->pNext = refClass.pFreeCells;
+			refClass.pFreeCells = pCell;
+		}
+	}
+
+	void ObjectPool::FreeBlocks(_Inout_ SizeClass& refClass) noexcept {
+		for (A_LPVOID lpBlock : refClass.Blocks)
+			::operator delete(lpBlock, std::align_val_t(c_uCacheLineSize));
+
+		refClass.Blocks.clear();
+		refClass.pFreeCells = nullptr;
+	}
+
+	_Ret_notnull_ A_LPVOID ObjectPool::Allocate(_In_ A_U64 uSize, _In_ A_U64 uAlignment) {
+		A_U32 uIndex = GetClassIndex(uSize, uAlignment);
+		if (uIndex == INVALID_SLOT)
+			return ::operator new(uSize, std::align_val_t(uAlignment > c_uCacheLineSize ? uAlignment : c_uCacheLineSize));
+
+		SizeClass& refClass = szClasses[uIndex];
+
+		if (!refClass.pFreeCells) {
+			A_BYTE* lpBlock = static_cast<A_BYTE*>(::operator new(c_uBlockSize, std::align_val_t(c_uCacheLineSize)));
+			refClass.Blocks.push_back(lpBlock);
+			CarveBlock(refClass, lpBlock, (uIndex + 1) * c_uCacheLineSize);
+		}
+
+		FreeCell* pCell = refClass.pFreeCells;
+		refClass.pFreeCells = pCell->pNext;
+		refClass.uLiveCells++;
+		return pCell;
+	}
+
+	void ObjectPool::Free(_In_ A_LPVOID lpCell, _In_ A_U64 uSize, _In_ A_U64 uAlignment) noexcept {
+		A_U32 uIndex = GetClassIndex(uSize, uAlignment);
+		if (uIndex == INVALID_SLOT) {
+			::operator delete(lpCell, std::align_val_t(uAlignment > c_uCacheLineSize ? uAlignment : c_uCacheLineSize));
+			return;
+		}
+
+		SizeClass& refClass = szClasses[uIndex];
+
+		if (!--refClass.uLiveCells) {
+			A_BYTE* lpKept = static_cast<A_BYTE*>(refClass.Blocks.back());
+			refClass.Blocks.pop_back();
+
+			FreeBlocks(refClass);
+
+			refClass.Blocks.push_back(lpKept);
+			CarveBlock(refClass, lpKept, (uIndex + 1) * c_uCacheLineSize);
+			return;
+		}
+
+		FreeCell* pCell = static_cast<FreeCell*>(lpCell);
+		pCell->pNext = refClass.pFreeCells;
+		refClass.pFreeCells = pCell;
+	}
+
+	A_U64 ObjectPool::GetReservedSize() const noexcept {
+		A_U64 uSize = 0;
+		for (const SizeClass& refClass : szClasses)
+			uSize += refClass.Blocks.size() * c_uBlockSize;
+		return uSize;
+	}
+}
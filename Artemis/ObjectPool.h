@@ -0,0 +1,57 @@
+#ifndef __ARTEMIS_OBJECT_POOL_H__
+#define __ARTEMIS_OBJECT_POOL_H__
+
+#include <vector>
+
+#include <Aurora/Definitions.h>
+
+#include "Definitions.h"
+
+namespace Artemis {
+	/// <summary>
+	/// <para>A pool of cache line aligned cells, grouped in size classes that are whole multiples of a cache line.</para>
+	/// <para>Cells are carved out of fixed size blocks. Once every cell of a size class has been freed, all of its blocks but one are returned to the heap at once. The last block is kept for the next allocation, so a size class that keeps going between one object and none does not go to the heap every time.</para>
+	/// <para>Requests too large or too strictly aligned for any size class are passed on to the heap. The pool is not thread safe.</para>
+	/// </summary>
+	class ARTEMIS_API ObjectPool {
+	public:
+		static constexpr A_U64 c_uCacheLineSize = 64;
+		static constexpr A_U64 c_uBlockSize = 4096;
+		static constexpr A_U32 c_uClassCount = 8; // Cells of 64 to 512 bytes.
+
+	private:
+		struct FreeCell {
+			FreeCell* pNext;
+		};
+
+		struct SizeClass {
+			std::vector<A_LPVOID> Blocks;
+			FreeCell* pFreeCells;
+			A_U64 uLiveCells;
+		};
+
+		SizeClass szClasses[c_uClassCount];
+
+		static A_U32 GetClassIndex(_In_ A_U64 uSize, _In_ A_U64 uAlignment) noexcept;
+
+		static void CarveBlock(_Inout_ SizeClass& refClass, _In_ A_BYTE* lpBlock, _In_ A_U64 uCellSize) noexcept;
+		void FreeBlocks(_Inout_ SizeClass& refClass) noexcept;
+
+	public:
+		ObjectPool() noexcept;
+		~ObjectPool();
+
+		ObjectPool(const ObjectPool&) = delete;
+		ObjectPool& operator=(const ObjectPool&) = delete;
+
+		_Ret_notnull_ A_LPVOID Allocate(_In_ A_U64 uSize, _In_ A_U64 uAlignment);
+		void Free(_In_ A_LPVOID lpCell, _In_ A_U64 uSize, _In_ A_U64 uAlignment) noexcept;
+
+		/// <summary>
+		/// Gets the number of bytes currently held in blocks, whether the cells are in use or not.
+		/// </summary>
+		A_U64 GetReservedSize() const noexcept;
+	};
+}
+
+#endif // !__ARTEMIS_OBJECT_POOL_H__
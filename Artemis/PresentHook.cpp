@@ -158,7 +158,48 @@ typedef HRESULT(APIENTRY* tPresent)(IDXGISwapChain*, UINT, UINT);
 tPresent oPresent;
 WNDPROC oWndProc;
 
+// Posts the key transitions of a window message to the keybind thread.
+static void PostInput(UINT uMsg, WPARAM wParam, LPARAM lParam) {
+	switch (uMsg) {
+	case WM_KEYDOWN:
+	case WM_SYSKEYDOWN:
+	case WM_KEYUP:
+	case WM_SYSKEYUP: {
+		bool bDown = uMsg == WM_KEYDOWN || uMsg == WM_SYSKEYDOWN;
+		UINT uKey = (UINT)wParam;
+
+		// Modifiers arrive as their generic keys, so tell the sides apart by the scan code and the extended key flag.
+		if (uKey == VK_SHIFT) uKey = MapVirtualKeyW((lParam >> 16) & 0xFF, MAPVK_VSC_TO_VK_EX);
+		else if (uKey == VK_CONTROL) uKey = lParam & (1 << 24) ? VK_RCONTROL : VK_LCONTROL;
+		else if (uKey == VK_MENU) uKey = lParam & (1 << 24) ? VK_RMENU : VK_LMENU;
+
+		Artemis::Keybinds.Post(uKey, bDown);
+		break;
+	}
+
+	case WM_LBUTTONDOWN: case WM_LBUTTONDBLCLK: Artemis::Keybinds.Post(VK_LBUTTON, true); break;
+	case WM_LBUTTONUP: Artemis::Keybinds.Post(VK_LBUTTON, false); break;
+	case WM_RBUTTONDOWN: case WM_RBUTTONDBLCLK: Artemis::Keybinds.Post(VK_RBUTTON, true); break;
+	case WM_RBUTTONUP: Artemis::Keybinds.Post(VK_RBUTTON, false); break;
+	case WM_MBUTTONDOWN: case WM_MBUTTONDBLCLK: Artemis::Keybinds.Post(VK_MBUTTON, true); break;
+	case WM_MBUTTONUP: Artemis::Keybinds.Post(VK_MBUTTON, false); break;
+	case WM_XBUTTONDOWN: case WM_XBUTTONDBLCLK: Artemis::Keybinds.Post(GET_XBUTTON_WPARAM(wParam) == XBUTTON1 ? VK_XBUTTON1 : VK_XBUTTON2, true); break;
+	case WM_XBUTTONUP: Artemis::Keybinds.Post(GET_XBUTTON_WPARAM(wParam) == XBUTTON1 ? VK_XBUTTON1 : VK_XBUTTON2, false); break;
+
+	// Keys released while the window is in the background never send their key-up messages.
+	case WM_KILLFOCUS: Artemis::Keybinds.PostReleaseAll(); break;
+	}
+}
+
+// Whether a window message may change what the UI looks like, so the UI must be built again.
+static bool IsUiInput(UINT uMsg) {
+	return (uMsg >= WM_MOUSEFIRST && uMsg <= WM_MOUSELAST) || (uMsg >= WM_KEYFIRST && uMsg <= WM_KEYLAST) || uMsg == WM_SETFOCUS || uMsg == WM_KILLFOCUS || uMsg == WM_SIZE;
+}
+
 LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+	PostInput(uMsg, wParam, lParam);
+	if (IsUiInput(uMsg)) Artemis::Throttle.NotifyInput();
+
 	if (ImGui_ImplWin32_WndProcHandler(hWnd, uMsg, wParam, lParam)) return TRUE;
 	return CallWindowProcW(oWndProc, hWnd, uMsg, wParam, lParam);
 }
@@ -205,26 +246,68 @@ HRESULT APIENTRY hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT F
 		else return oPresent(pSwapChain, SyncInterval, Flags);
 	}
 
-	ImGui_ImplDX11_NewFrame();
-	ImGui_ImplWin32_NewFrame();
-	ImGui::NewFrame();
+	{
+		ARTEMIS_TIME_FRAME_PHASE(Artemis::FramePhases, Total);
+
+		{
+			ARTEMIS_TIME_FRAME_PHASE(Artemis::FramePhases, Update);
+			Artemis::EventEntries.Invoke();
+		}
+
+		// The UI is only built when it may look different, and at most at the update rate unless a layer is drawn every frame. The other frames submit the draw data of the last built frame again.
+		Artemis::FrameDemand Demand = Artemis::DrawManagers.IsUpdateDue();
+		if (Demand == Artemis::FrameDemand::None && Artemis::Windows.IsUpdateDue())
+			Demand = Artemis::FrameDemand::Dirty;
 
-	Artemis::Engine::Events::OnNewFrameEventArgs e;
-	Artemis::Engine::Events::OnNewFrameEvent.Invoke(nullptr, &e);
+		if (Artemis::Throttle.ShouldUpdate(Artemis::KeybindManager::GetTimestamp(), Demand)) {
+			// The keybind calls recorded so far are drawn by this frame.
+			Artemis::Keybinds.GetLatency().BeginFrame();
 
-	Artemis::DrawManagers.PresentAll(ImGui::GetForegroundDrawList(), ImGui::GetBackgroundDrawList());
-	Artemis::EventEntries.Invoke();
-	Artemis::Windows.PresentAll();
+			{
+				ARTEMIS_TIME_FRAME_PHASE(Artemis::FramePhases, Build);
 
-	ImGui::ShowStyleEditor();
-	ImGui::ShowDemoWindow();
+				ImGui_ImplDX11_NewFrame();
+				ImGui_ImplWin32_NewFrame();
+				ImGui::NewFrame();
 
-	ImGui::EndFrame();
-	ImGui::Render();
-	pDeviceContext->OMSetRenderTargets(1, &pRenderTargetView, nullptr);
-	ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+				Artemis::AsyncEvents.DispatchDeferred();
+
+				// The render-thread handlers draw into the new frame, so only the rest are left to the queue.
+				Artemis::Engine::Events::OnNewFrameEventArgs e;
+				Artemis::Engine::Events::OnNewFrameEvent.Invoke(nullptr, &e, Aurora::EventHandlerAffinity::RenderThread);
+				Artemis::AsyncEvents.Enqueue(Artemis::Engine::Events::OnNewFrameEvent, nullptr, &e, false);
+
+				Artemis::DrawManagers.PresentAll(ImGui::GetForegroundDrawList(), ImGui::GetBackgroundDrawList());
+				Artemis::Windows.PresentAll();
+
+				ImGui::ShowStyleEditor();
+				ImGui::ShowDemoWindow();
+
+				ImGui::EndFrame();
+			}
+
+			ARTEMIS_TIME_FRAME_PHASE(Artemis::FramePhases, Render);
+			ImGui::Render();
+		}
+
+		{
+			// The draw data stays valid until the next ImGui::NewFrame, so it can be submitted again as it is.
+			ARTEMIS_TIME_FRAME_PHASE(Artemis::FramePhases, Submit);
+			pDeviceContext->OMSetRenderTargets(1, &pRenderTargetView, nullptr);
+			ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+		}
+
+		Artemis::DrawManagers.Quiesce();
+		Artemis::EventEntries.Quiesce();
+		Artemis::Windows.Quiesce();
+
+		Artemis::FrameArena::Current().Reset();
+	}
 
-	return oPresent(pSwapChain, SyncInterval, Flags);
+	// Present may block until the frame is queued for display, so the latency is only taken once it returns.
+	HRESULT hResult = oPresent(pSwapChain, SyncInterval, Flags);
+	Artemis::Keybinds.GetLatency().Present(Artemis::KeybindManager::GetTimestamp());
+	return hResult;
 }
 
 PresentHook::PresentHook() {
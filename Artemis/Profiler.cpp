@@ -0,0 +1,67 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace Artemis {
+	// The counters at load time. The tick rate is measured against the steady clock, which is the performance counter on Windows, over the time since then.
+	static const A_U64 s_uStartTicks = __rdtsc();
+	static const std::chrono::steady_clock::time_point s_StartTime = std::chrono::steady_clock::now();
+
+	ARTEMIS_API A_FL64 TicksToNanoseconds(_In_ A_U64 uTicks) {
+		A_U64 uElapsedTicks;
+		A_FL64 fElapsedNanoseconds;
+		do {
+			std::chrono::steady_clock::time_point Now = std::chrono::steady_clock::now();
+			uElapsedTicks = __rdtsc() - s_uStartTicks;
+			fElapsedNanoseconds = std::chrono::duration<A_FL64, std::nano>(Now - s_StartTime).count();
+		} while (fElapsedNanoseconds < 1e6);
+
+		return static_cast<A_FL64>(uTicks) * fElapsedNanoseconds / static_cast<A_FL64>(uElapsedTicks);
+	}
+
+	ARTEMIS_API void KeepTopOffenders(_Inout_ std::vector<TimingReport>& refReports, _In_ A_U32 uCount) {
+		std::sort(refReports.begin(), refReports.end(), [](const TimingReport& refLeft, const TimingReport& refRight) {
+			return refLeft.Statistics.fAverage > refRight.Statistics.fAverage;
+		});
+
+		if (refReports.size() > uCount)
+			refReports.resize(uCount);
+	}
+
+#ifdef ARTEMIS_PROFILE
+	InvocableTimings::InvocableTimings() noexcept : uCalls(0) {
+		for (std::atomic<A_U32>& refSample : szSamples)
+			refSample.store(0, std::memory_order_relaxed);
+	}
+
+	TimingStatistics InvocableTimings::GetStatistics() const {
+		TimingStatistics Statistics = { uCalls.load(std::memory_order_relaxed), 0.0, 0.0, 0.0 };
+
+		A_U32 uSampleCount = Statistics.uCalls < c_uSampleCount ? static_cast<A_U32>(Statistics.uCalls) : c_uSampleCount;
+		if (!uSampleCount) return Statistics;
+
+		A_U32 szSorted[c_uSampleCount];
+		A_U64 uTotal = 0;
+		for (A_U32 i = 0; i < uSampleCount; i++) {
+			szSorted[i] = szSamples[i].load(std::memory_order_relaxed);
+			uTotal += szSorted[i];
+		}
+
+		std::sort(szSorted, szSorted + uSampleCount);
+
+		Statistics.fMinimum = TicksToNanoseconds(szSorted[0]);
+		Statistics.fAverage = TicksToNanoseconds(uTotal) / uSampleCount;
+		Statistics.fP99 = TicksToNanoseconds(szSorted[(uSampleCount * 99) / 100]);
+		return Statistics;
+	}
+
+	void FramePhaseTimings::QueryTimings(_Inout_ std::vector<TimingReport>& refReports) const {
+		static constexpr const char* c_szPhaseNames[] = { "Update", "Build", "Render", "Submit", "Total" };
+		static_assert(sizeof(c_szPhaseNames) / sizeof(*c_szPhaseNames) == static_cast<A_U32>(FramePhase::Count));
+
+		for (A_U32 i = 0; i < static_cast<A_U32>(FramePhase::Count); i++)
+			refReports.push_back({ c_szPhaseNames[i], szPhases[i].GetStatistics() });
+	}
+#endif // ARTEMIS_PROFILE
+}
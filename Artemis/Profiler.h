@@ -0,0 +1,103 @@
+#ifndef __ARTEMIS_PROFILER_H__
+#define __ARTEMIS_PROFILER_H__
+
+#include <atomic>
+#include <vector>
+
+#include <intrin.h>
+
+#include <Aurora/Definitions.h>
+
+#include "Definitions.h"
+
+namespace Artemis {
+	struct TimingStatistics {
+		A_U64 uCalls;		// The number of recorded calls.
+		A_FL64 fMinimum;	// The shortest call in the sample window, in nanoseconds.
+		A_FL64 fAverage;	// The average call in the sample window, in nanoseconds.
+		A_FL64 fP99;		// The 99th percentile of the sample window, in nanoseconds.
+	};
+
+	struct TimingReport {
+		const char* lpTypeName;
+		TimingStatistics Statistics;
+	};
+
+	/// <summary>
+	/// Converts a number of time stamp counter ticks to nanoseconds.
+	/// </summary>
+	ARTEMIS_API A_FL64 TicksToNanoseconds(_In_ A_U64 uTicks);
+
+	/// <summary>
+	/// Sorts the reports by their average call time, longest first, and drops all but the first uCount reports.
+	/// </summary>
+	ARTEMIS_API void KeepTopOffenders(_Inout_ std::vector<TimingReport>& refReports, _In_ A_U32 uCount);
+
+#ifdef ARTEMIS_PROFILE
+	/// <summary>
+	/// A ring buffer of the most recent call times of a single invocable. Written only by the invoking thread.
+	/// </summary>
+	class ARTEMIS_API InvocableTimings {
+		static constexpr A_U32 c_uSampleCount = 128;
+
+		std::atomic<A_U32> szSamples[c_uSampleCount];
+		std::atomic<A_U64> uCalls;
+
+	public:
+		InvocableTimings() noexcept;
+
+		inline void Record(_In_ A_U64 uTicks) noexcept {
+			A_U64 uCall = uCalls.load(std::memory_order_relaxed);
+			szSamples[uCall % c_uSampleCount].store(uTicks > 0xFFFFFFFF ? 0xFFFFFFFF : static_cast<A_U32>(uTicks), std::memory_order_relaxed);
+			uCalls.store(uCall + 1, std::memory_order_relaxed);
+		}
+
+		TimingStatistics GetStatistics() const;
+	};
+
+	class ScopedInvocationTimer {
+		InvocableTimings* pTimings;
+		A_U64 uStart;
+
+	public:
+		inline explicit ScopedInvocationTimer(_In_ InvocableTimings* pTimings) noexcept : pTimings(pTimings), uStart(__rdtsc()) {}
+		inline ~ScopedInvocationTimer() { pTimings->Record(__rdtsc() - uStart); }
+	};
+
+#define ARTEMIS_TIME_INVOCATION(refRange, nIndex) ::Artemis::ScopedInvocationTimer _InvocationTimer((refRange).ppTimings[nIndex])
+#else
+#define ARTEMIS_TIME_INVOCATION(refRange, nIndex)
+#endif // ARTEMIS_PROFILE
+
+	enum class FramePhase : A_U32 {
+		Update,	// The work done on every frame, like invoking the event entries.
+		Build,	// From ImGui::NewFrame to ImGui::EndFrame. Only timed on the frames the UI is built on.
+		Render,	// ImGui::Render. Only timed on the frames the UI is built on.
+		Submit,	// Rendering the draw data, or the draw data of the last built frame on the other frames.
+		Total,	// The whole present hook, without the original Present.
+		Count
+	};
+
+#ifdef ARTEMIS_PROFILE
+	/// <summary>
+	/// The times spent in each phase of the present hook. Written only by the render thread.
+	/// </summary>
+	class ARTEMIS_API FramePhaseTimings {
+		InvocableTimings szPhases[static_cast<A_U32>(FramePhase::Count)];
+
+	public:
+		inline InvocableTimings* Get(_In_ FramePhase Phase) noexcept { return &szPhases[static_cast<A_U32>(Phase)]; }
+
+		/// <summary>
+		/// Appends a report per phase, in phase order, named after the phase.
+		/// </summary>
+		void QueryTimings(_Inout_ std::vector<TimingReport>& refReports) const;
+	};
+
+#define ARTEMIS_TIME_FRAME_PHASE(refTimings, Phase) ::Artemis::ScopedInvocationTimer _PhaseTimer##Phase((refTimings).Get(::Artemis::FramePhase::Phase))
+#else
+#define ARTEMIS_TIME_FRAME_PHASE(refTimings, Phase)
+#endif // ARTEMIS_PROFILE
+}
+
+#endif // !__ARTEMIS_PROFILER_H__
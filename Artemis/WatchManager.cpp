@@ -0,0 +1,230 @@
+#include "pch.h"
+#include "WatchManager.h"
+
+#include <algorithm>
+
+namespace Artemis {
+	WatchManager::WatchManager() : bStopping(false), bRescheduled(false), bDelivering(false), uDeliveries(0), Statistics() {}
+
+	WatchManager::~WatchManager() { Stop(); }
+
+	WatchHandle WatchManager::AddEntry(_In_ Entry&& refEntry) {
+		if (!refEntry.uInterval) refEntry.uInterval = 1;
+
+		std::lock_guard<std::mutex> Guard(Lock);
+
+		A_U32 uSlot;
+		if (FreeSlots.empty()) {
+			uSlot = static_cast<A_U32>(Entries.size());
+			refEntry.uGeneration = 0;
+			Entries.push_back(std::move(refEntry));
+		}
+		else {
+			uSlot = FreeSlots.back();
+			FreeSlots.pop_back();
+			refEntry.uGeneration = Entries[uSlot].uGeneration;
+			Entries[uSlot] = std::move(refEntry);
+		}
+
+		Entry& refSlot = Entries[uSlot];
+		refSlot.bAlive = true;
+		refSlot.bSampled = false;
+
+		auto itGroup = std::find_if(Groups.begin(), Groups.end(), [&](const RateGroup& refGroup) { return refGroup.uInterval == refSlot.uInterval; });
+		if (itGroup == Groups.end()) {
+			Groups.push_back({ refSlot.uInterval, std::chrono::steady_clock::now(), {} });
+			itGroup = Groups.end() - 1;
+		}
+		itGroup->Slots.push_back(uSlot);
+
+		bRescheduled = true;
+		WakeUp.notify_all();
+
+		return WatchHandle(uSlot, refSlot.uGeneration);
+	}
+
+	bool WatchManager::Release(_In_ WatchHandle hWatch) {
+		std::unique_lock<std::mutex> Guard(Lock);
+		if (hWatch.uSlot >= Entries.size()) return false;
+
+		Entry& refEntry = Entries[hWatch.uSlot];
+		if (!refEntry.bAlive || refEntry.uGeneration != hWatch.uGeneration) return false;
+
+		auto itGroup = std::find_if(Groups.begin(), Groups.end(), [&](const RateGroup& refGroup) { return refGroup.uInterval == refEntry.uInterval; });
+		std::erase(itGroup->Slots, hWatch.uSlot);
+		if (itGroup->Slots.empty()) Groups.erase(itGroup);
+
+		refEntry.bAlive = false;
+		refEntry.uGeneration++;
+		refEntry.Offsets.clear();
+		FreeSlots.push_back(hWatch.uSlot);
+
+		// Wait out a delivery that started before the watch was removed. On the sampler thread, the caller is a handler of the delivery, which skips the watch instead.
+		if (std::this_thread::get_id() == SamplerId)
+			DeliveryReleases.push_back(hWatch);
+		else {
+			A_U64 uDelivery = uDeliveries;
+			DeliveryDone.wait(Guard, [&] { return !bDelivering || uDeliveries != uDelivery; });
+		}
+
+		return true;
+	}
+
+	void WatchManager::Start() {
+		std::lock_guard<std::mutex> Guard(Lock);
+		if (Sampler.joinable()) return;
+
+		bStopping = false;
+		Sampler = std::thread(&WatchManager::SamplerMain, this);
+		SamplerId = Sampler.get_id();
+	}
+
+	void WatchManager::Stop() {
+		{
+			std::lock_guard<std::mutex> Guard(Lock);
+			if (!Sampler.joinable()) return;
+
+			bStopping = true;
+		}
+		WakeUp.notify_all();
+
+		Sampler.join();
+
+		std::lock_guard<std::mutex> Guard(Lock);
+		SamplerId = std::thread::id();
+	}
+
+	WatchStatistics WatchManager::GetStatistics() {
+		std::lock_guard<std::mutex> Guard(Lock);
+		return Statistics;
+	}
+
+	void WatchManager::SamplerMain() {
+		std::unique_lock<std::mutex> Guard(Lock);
+
+		while (!bStopping) {
+			bRescheduled = false;
+
+			std::chrono::steady_clock::time_point Now = std::chrono::steady_clock::now();
+			std::chrono::steady_clock::time_point NextSample = std::chrono::steady_clock::time_point::max();
+
+			for (RateGroup& refGroup : Groups) {
+				if (refGroup.NextSample <= Now) {
+					Sample(refGroup);
+
+					// Samples that were missed are skipped, rather than run back to back.
+					refGroup.NextSample += std::chrono::milliseconds(refGroup.uInterval);
+					if (refGroup.NextSample <= Now)
+						refGroup.NextSample = Now + std::chrono::milliseconds(refGroup.uInterval);
+				}
+
+				if (refGroup.NextSample < NextSample)
+					NextSample = refGroup.NextSample;
+			}
+
+			if (!Notifications.empty()) {
+				bDelivering = true;
+				Guard.unlock();
+
+				// Only handlers on this thread add to DeliveryReleases while Lock is released, so it is read without the lock.
+				for (const Notification& refNotification : Notifications)
+					if (std::find(DeliveryReleases.begin(), DeliveryReleases.end(), refNotification.hWatch) == DeliveryReleases.end())
+						refNotification.pfnNotify(refNotification.lpEvent, this, refNotification.hWatch, refNotification.szOld, refNotification.szNew);
+
+				Guard.lock();
+				bDelivering = false;
+				uDeliveries++;
+				DeliveryDone.notify_all();
+
+				Notifications.clear();
+				DeliveryReleases.clear();
+			}
+
+			if (NextSample == std::chrono::steady_clock::time_point::max())
+				WakeUp.wait(Guard, [&] { return bStopping || bRescheduled; });
+			else
+				WakeUp.wait_until(Guard, NextSample, [&] { return bStopping || bRescheduled; });
+		}
+	}
+
+	void WatchManager::Sample(_In_ const RateGroup& refGroup) {
+		Reads.clear();
+
+		for (A_U32 uSlot : refGroup.Slots) {
+			const Entry& refEntry = Entries[uSlot];
+			A_ADDR uAddress = refEntry.uAddress;
+
+			try {
+				for (A_ADDR uOffset : refEntry.Offsets)
+					uAddress = Aurora::Read<A_ADDR>(uAddress) + uOffset;
+			}
+			catch (const Aurora::Exception&) {
+				Statistics.uFailedReads++;
+				continue;
+			}
+
+			Reads.push_back({ uAddress, uSlot });
+		}
+
+		std::sort(Reads.begin(), Reads.end(), [](const PendingRead& refLeft, const PendingRead& refRight) { return refLeft.uAddress < refRight.uAddress; });
+
+		Statistics.uPasses++;
+		Statistics.uSampledWatches += Reads.size();
+
+		for (size_t uBegin = 0, uEnd; uBegin < Reads.size(); uBegin = uEnd) {
+			A_ADDR uSpanBegin = Reads[uBegin].uAddress;
+			A_ADDR uSpanEnd = uSpanBegin + Entries[Reads[uBegin].uSlot].uSize;
+
+			// Extend the span over the following values for as long as the gaps and the span stay small.
+			for (uEnd = uBegin + 1; uEnd < Reads.size(); uEnd++) {
+				A_ADDR uValueBegin = Reads[uEnd].uAddress;
+				A_ADDR uValueEnd = (std::max)(uSpanEnd, uValueBegin + Entries[Reads[uEnd].uSlot].uSize);
+
+				if (uValueBegin > uSpanEnd + c_uMaxCoalesceGap || uValueEnd - uSpanBegin > c_uMaxCoalescedRead) break;
+				uSpanEnd = uValueEnd;
+			}
+
+			if (ReadSpan(uSpanBegin, uSpanEnd)) {
+				for (size_t i = uBegin; i < uEnd; i++)
+					Update(Reads[i].uSlot, szBuffer + (Reads[i].uAddress - uSpanBegin));
+			}
+			else if (uEnd - uBegin > 1) {
+				// Part of the span could not be read, so read its values one by one to salvage the rest.
+				for (size_t i = uBegin; i < uEnd; i++) {
+					A_ADDR uAddress = Reads[i].uAddress;
+					if (ReadSpan(uAddress, uAddress + Entries[Reads[i].uSlot].uSize))
+						Update(Reads[i].uSlot, szBuffer);
+				}
+			}
+		}
+	}
+
+	bool WatchManager::ReadSpan(_In_ A_ADDR uBegin, _In_ A_ADDR uEnd) {
+		Statistics.uReads++;
+
+		try {
+			Aurora::Read(uBegin, szBuffer, static_cast<A_DWORD>(uEnd - uBegin));
+			return true;
+		}
+		catch (const Aurora::Exception&) {
+			Statistics.uFailedReads++;
+			return false;
+		}
+	}
+
+	void WatchManager::Update(_In_ A_U32 uSlot, _In_ const A_BYTE* lpValue) {
+		Entry& refEntry = Entries[uSlot];
+
+		if (refEntry.bSampled && refEntry.pfnCompare(refEntry.Condition, refEntry.szValue, lpValue, refEntry.szReference)) {
+			Notification& refNotification = Notifications.emplace_back();
+			refNotification.hWatch = WatchHandle(uSlot, refEntry.uGeneration);
+			refNotification.pfnNotify = refEntry.pfnNotify;
+			refNotification.lpEvent = refEntry.lpEvent;
+			memcpy(refNotification.szOld, refEntry.szValue, refEntry.uSize);
+			memcpy(refNotification.szNew, lpValue, refEntry.uSize);
+		}
+
+		memcpy(refEntry.szValue, lpValue, refEntry.uSize);
+		refEntry.bSampled = true;
+	}
+}
\ No newline at end of file
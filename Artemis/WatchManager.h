@@ -0,0 +1,250 @@
+#ifndef __ARTEMIS_WATCH_MANAGER_H__
+#define __ARTEMIS_WATCH_MANAGER_H__
+
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <Aurora/Definitions.h>
+#include <Aurora/Events.h>
+#include <Aurora/MemoryTypes.h>
+#include <Aurora/ProcessInfo.h>
+
+#include "Definitions.h"
+
+namespace Artemis {
+	/// <summary>
+	/// A generation tagged handle to a watch registered in a watch manager.
+	/// A handle becomes stale once the watch it refers to is released, even if its slot is reused.
+	/// </summary>
+	struct WatchHandle {
+		A_U32 uSlot;
+		A_U32 uGeneration;
+
+		constexpr WatchHandle() noexcept : uSlot(INVALID_SLOT), uGeneration(0) {}
+		constexpr WatchHandle(_In_ A_U32 uSlot, _In_ A_U32 uGeneration) noexcept : uSlot(uSlot), uGeneration(uGeneration) {}
+
+		constexpr bool IsValid() const noexcept { return uSlot != INVALID_SLOT; }
+
+		constexpr bool operator==(const WatchHandle&) const noexcept = default;
+	};
+
+	enum class WatchCondition : int {
+		Changed,	// The value differs bitwise from the previous sample.
+		Increased,	// The value is greater than the previous sample.
+		Decreased,	// The value is less than the previous sample.
+		Reached,	// The value became equal to the reference value.
+		Left		// The value stopped being equal to the reference value.
+	};
+
+	template<class T>
+	concept WatchableType = std::is_trivially_copyable_v<T> && std::default_initializable<T> && std::equality_comparable<T> && sizeof(T) <= 32;
+
+	template<WatchableType T>
+	struct WatchEventArgs {
+		WatchHandle hWatch;
+		T OldValue;
+		T NewValue;
+	};
+
+	struct WatchStatistics {
+		A_U64 uPasses;			// The number of times a rate group was sampled.
+		A_U64 uSampledWatches;
+		A_U64 uReads;			// The number of reads issued for the values, after coalescing.
+		A_U64 uFailedReads;
+	};
+
+	/// <summary>
+	/// <para>Samples values in memory on a thread of its own and raises an event whenever a value meets the condition of its watch.</para>
+	/// <para>Watches are grouped by their sampling interval. Every time a group is due, the values of its watches are sorted by address, and values that lie close together are read with a single read.</para>
+	/// <para>The first sample of a watch only records the value. Values that cannot be read are skipped until they can be read again.</para>
+	/// <para>Events are raised on the sampler thread. The event of a watch must outlive the watch, and once Release returns on any other thread, the event is not raised for it again.</para>
+	/// </summary>
+	class ARTEMIS_API WatchManager {
+	public:
+		static constexpr A_U32 c_uMaxValueSize = 32;
+		static constexpr A_U32 c_uMaxCoalesceGap = 64;		// The largest gap between two values that is read over rather than split into two reads.
+		static constexpr A_U32 c_uMaxCoalescedRead = 4096;	// The largest read that several values are coalesced into.
+
+	private:
+		using Comparer = bool(*)(_In_ WatchCondition Condition, _In_ const A_BYTE* lpOld, _In_ const A_BYTE* lpNew, _In_ const A_BYTE* lpReference);
+		using Notifier = void(*)(_In_ A_LPVOID lpEvent, _In_ WatchManager* pSender, _In_ WatchHandle hWatch, _In_ const A_BYTE* lpOld, _In_ const A_BYTE* lpNew);
+
+		template<WatchableType T>
+		static bool Compare(_In_ WatchCondition Condition, _In_ const A_BYTE* lpOld, _In_ const A_BYTE* lpNew, _In_ const A_BYTE* lpReference) {
+			if (Condition == WatchCondition::Changed) return memcmp(lpOld, lpNew, sizeof(T)) != 0;
+
+			T Old, New, Reference;
+			memcpy(&Old, lpOld, sizeof(T));
+			memcpy(&New, lpNew, sizeof(T));
+			memcpy(&Reference, lpReference, sizeof(T));
+
+			switch (Condition) {
+			case WatchCondition::Increased:
+				if constexpr (std::totally_ordered<T>) return Old < New;
+				else return false;
+			case WatchCondition::Decreased:
+				if constexpr (std::totally_ordered<T>) return New < Old;
+				else return false;
+			case WatchCondition::Reached: return New == Reference && !(Old == Reference);
+			case WatchCondition::Left: return Old == Reference && !(New == Reference);
+			default: return false;
+			}
+		}
+
+		template<WatchableType T>
+		static void Notify(_In_ A_LPVOID lpEvent, _In_ WatchManager* pSender, _In_ WatchHandle hWatch, _In_ const A_BYTE* lpOld, _In_ const A_BYTE* lpNew) {
+			WatchEventArgs<T> e;
+			e.hWatch = hWatch;
+			memcpy(&e.OldValue, lpOld, sizeof(T));
+			memcpy(&e.NewValue, lpNew, sizeof(T));
+			static_cast<Aurora::Event<WatchEventArgs<T>>*>(lpEvent)->Invoke(pSender, &e);
+		}
+
+		struct Entry {
+			A_ADDR uAddress;				// The address of the value, or the base address of its pointer chain.
+			std::vector<A_ADDR> Offsets;	// The offsets of the pointer chain, empty if uAddress is the address of the value.
+			A_U32 uSize;
+			A_U32 uInterval;
+			A_U32 uGeneration;
+			bool bAlive;
+			bool bSampled;
+			WatchCondition Condition;
+			Comparer pfnCompare;
+			Notifier pfnNotify;
+			A_LPVOID lpEvent;
+			A_BYTE szReference[c_uMaxValueSize];
+			A_BYTE szValue[c_uMaxValueSize];
+		};
+
+		struct RateGroup {
+			A_U32 uInterval;
+			std::chrono::steady_clock::time_point NextSample;
+			std::vector<A_U32> Slots;
+		};
+
+		struct PendingRead {
+			A_ADDR uAddress;
+			A_U32 uSlot;
+		};
+
+		struct Notification {
+			WatchHandle hWatch;
+			Notifier pfnNotify;
+			A_LPVOID lpEvent;
+			A_BYTE szOld[c_uMaxValueSize];
+			A_BYTE szNew[c_uMaxValueSize];
+		};
+
+		std::mutex Lock;
+		std::condition_variable WakeUp;
+		std::condition_variable DeliveryDone;
+		std::thread Sampler;
+		std::thread::id SamplerId;
+		bool bStopping;
+		bool bRescheduled;
+		bool bDelivering; // Set while events are raised with Lock released, so Release can wait out a delivery that may include its watch.
+		A_U64 uDeliveries;
+
+		std::vector<Entry> Entries;
+		std::vector<A_U32> FreeSlots;
+		std::vector<RateGroup> Groups;
+
+		// Reused by every pass, so sampling does not allocate once they have grown.
+		std::vector<PendingRead> Reads;
+		std::vector<Notification> Notifications;
+		std::vector<WatchHandle> DeliveryReleases; // The watches released by handlers during the current delivery.
+		A_BYTE szBuffer[c_uMaxCoalescedRead];
+
+		WatchStatistics Statistics;
+
+		WatchHandle AddEntry(_In_ Entry&& refEntry);
+
+		void SamplerMain();
+		void Sample(_In_ const RateGroup& refGroup);
+		bool ReadSpan(_In_ A_ADDR uBegin, _In_ A_ADDR uEnd);
+		void Update(_In_ A_U32 uSlot, _In_ const A_BYTE* lpValue);
+
+	public:
+		WatchManager();
+		~WatchManager();
+
+		WatchManager(const WatchManager&) = delete;
+		WatchManager& operator=(const WatchManager&) = delete;
+
+		/// <summary>
+		/// Watches the value at uAddress, sampling it every uInterval milliseconds.
+		/// </summary>
+		template<WatchableType T>
+		inline WatchHandle Add(
+			_In_ A_ADDR uAddress,
+			_In_ A_U32 uInterval,
+			_In_ Aurora::Event<WatchEventArgs<T>>& refEvent,
+			_In_ WatchCondition Condition = WatchCondition::Changed,
+			_In_ const T& refReference = T()
+		) {
+			Entry NewEntry = {};
+			NewEntry.uAddress = uAddress;
+			NewEntry.uSize = sizeof(T);
+			NewEntry.uInterval = uInterval;
+			NewEntry.Condition = Condition;
+			NewEntry.pfnCompare = &Compare<T>;
+			NewEntry.pfnNotify = &Notify<T>;
+			NewEntry.lpEvent = &refEvent;
+			memcpy(NewEntry.szReference, &refReference, sizeof(T));
+
+			return AddEntry(std::move(NewEntry));
+		}
+
+		/// <summary>
+		/// Watches the value at the end of a pointer chain, sampling it every uInterval milliseconds. The chain is followed again on every sample.
+		/// </summary>
+		template<WatchableType T>
+		inline WatchHandle Add(
+			_In_ const Aurora::ModuleInfo& refModule,
+			_In_ const Aurora::BasePointer<T>& refPointer,
+			_In_ A_U32 uInterval,
+			_In_ Aurora::Event<WatchEventArgs<T>>& refEvent,
+			_In_ WatchCondition Condition = WatchCondition::Changed,
+			_In_ const T& refReference = T()
+		) {
+			Entry NewEntry = {};
+			NewEntry.uAddress = refModule.GetModuleBaseAddress() + refPointer.GetOffset();
+			for (A_ADDR uOffset : refPointer)
+				NewEntry.Offsets.push_back(uOffset);
+			NewEntry.uSize = sizeof(T);
+			NewEntry.uInterval = uInterval;
+			NewEntry.Condition = Condition;
+			NewEntry.pfnCompare = &Compare<T>;
+			NewEntry.pfnNotify = &Notify<T>;
+			NewEntry.lpEvent = &refEvent;
+			memcpy(NewEntry.szReference, &refReference, sizeof(T));
+
+			return AddEntry(std::move(NewEntry));
+		}
+
+		/// <summary>
+		/// Stops watching a value. Returns false if the handle is stale.
+		/// </summary>
+		bool Release(_In_ WatchHandle hWatch);
+
+		/// <summary>
+		/// Starts the sampler thread. Watches may be added before or after it has started.
+		/// </summary>
+		void Start();
+
+		/// <summary>
+		/// Stops the sampler thread and waits for it to exit. Must be called before the module is unloaded.
+		/// </summary>
+		void Stop();
+
+		WatchStatistics GetStatistics();
+	};
+}
+
+#endif // !__ARTEMIS_WATCH_MANAGER_H__
\ No newline at end of file
@@ -3,10 +3,12 @@
 
 namespace Artemis {
 	bool g_bVisible = true;
+	std::atomic<A_U32> g_uVisibilityChanges = 0; // Bumped whenever a window is shown or hidden, so the window manager can tell that it must present again.
 
-	IWindow::IWindow(_In_z_ const char* lpWindowName, bool bVisible) {
+	IWindow::IWindow(_In_z_ const char* lpWindowName, bool bVisible, A_I32 nPriority) {
 		strcpy_s(szWindowName, lpWindowName);
 		this->bVisible = bVisible;
+		this->nPriority = nPriority;
 	}
 
 	const char* IWindow::GetWindowName() const { return szWindowName; }
@@ -14,19 +16,55 @@ namespace Artemis {
 	bool IWindow::GetWindowVisibility() const { return bVisible; }
 	bool* IWindow::GetWindowVisibilityPtr() { return &bVisible; }
 
-	void IWindow::SetWindowVisibility(bool bVisible) { this->bVisible = bVisible; }
+	void IWindow::SetWindowVisibility(bool bVisible) {
+		this->bVisible = bVisible;
+		g_uVisibilityChanges.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	A_I32 IWindow::GetPriority() const { return nPriority; }
 
 	void IWindow::Present() {
-		if (g_bVisible && bVisible) {
-			if (ImGui::Begin(szWindowName))
-				Window();
-			ImGui::End();
+		if (BeginPresent()) {
+			Window();
+			EndPresent();
 		}
 	}
 
+	bool IWindow::BeginPresent() {
+		if (!g_bVisible || !bVisible) return false;
+		if (ImGui::Begin(szWindowName)) return true;
+
+		ImGui::End();
+		return false;
+	}
+
+	void IWindow::EndPresent() { ImGui::End(); }
+
+	WindowManager::WindowManager() : uPresentedEpoch(~0ULL), uPresentedVisibility(0) {}
+
+	bool WindowManager::GetGlobalWindowVisibility() { return g_bVisible; }
+
+	void WindowManager::SetGlobalWindowVisibility(bool bVisibility) {
+		g_bVisible = bVisibility;
+		g_uVisibilityChanges.fetch_add(1, std::memory_order_relaxed);
+	}
+
 	void WindowManager::PresentAll() {
-		for (IWindow* pWindow : InvocableCollection)
-			if (pWindow)
-				pWindow->Present();
+		uPresentedEpoch = AcquireSnapshot()->uEpoch;
+		uPresentedVisibility = g_uVisibilityChanges.load(std::memory_order_relaxed);
+
+		const InvokeContext Context = {};
+		InvokeAll(&Context);
+	}
+
+	bool WindowManager::IsUpdateDue() const {
+		const Snapshot* pSnapshot = AcquireSnapshot();
+		if (pSnapshot->uEpoch != uPresentedEpoch || g_uVisibilityChanges.load(std::memory_order_relaxed) != uPresentedVisibility) return true;
+		if (!g_bVisible) return false;
+
+		for (const IWindow* pWindow : pSnapshot->Objects)
+			if (pWindow->GetWindowVisibility() && pWindow->IsDirty())
+				return true;
+		return false;
 	}
 }
\ No newline at end of file
@@ -10,9 +10,12 @@ namespace Artemis {
 	class ARTEMIS_API IWindow {
 		bool bVisible;
 		char szWindowName[MAX_NAME];
+		A_I32 nPriority;
 
 	public:
-		IWindow(_In_z_ const char* lpWindowName, bool bVisible);
+		struct InvokeContext {};
+
+		IWindow(_In_z_ const char* lpWindowName, bool bVisible, A_I32 nPriority = 0);
 
 		const char* GetWindowName() const;
 
@@ -21,25 +24,60 @@ namespace Artemis {
 
 		void SetWindowVisibility(bool bVisible);
 
+		A_I32 GetPriority() const;
+
+		virtual ~IWindow() = default;
+
 		virtual void Window() = 0;
 
+		/// <summary>
+		/// Whether the window has changed without input since it was last presented. Windows are only presented again on the frames the UI is built on, so a window that only changes with input can return false to let the UI be built less often.
+		/// </summary>
+		virtual bool IsDirty() const { return true; }
+
 		void Present();
+
+		bool BeginPresent();
+		void EndPresent();
+
+		template<std::derived_from<IWindow> T>
+		static void InvokeRange(_In_ const InvocableRange<IWindow>& refRange, _In_ const InvokeContext&) {
+			for (A_U32 i = 0; i < refRange.uCount; i++) {
+				T* pWindow = static_cast<T*>(refRange.ppObjects[i]);
+				ARTEMIS_TIME_INVOCATION(refRange, i);
+
+				if (pWindow->BeginPresent()) {
+					pWindow->Window();
+					pWindow->EndPresent();
+				}
+			}
+		}
 	};
 
-	using WindowIndex = int;
+	using WindowHandle = InvocableHandle<IWindow>;
 
 #ifdef _ARTEMIS_EXPORT
-	extern template class Manager<IWindow, WindowIndex>;
+	extern template class Manager<IWindow>;
 #else
-	template class ARTEMIS_IMPORT Manager<IWindow, WindowIndex>;
+	template class ARTEMIS_IMPORT Manager<IWindow>;
 #endif // _ARTEMIS_EXPORT
 
-	class ARTEMIS_API WindowManager : public Manager<IWindow, WindowIndex> {
+	class ARTEMIS_API WindowManager : public Manager<IWindow> {
+		A_U64 uPresentedEpoch;			// The epoch of the snapshot that was last presented.
+		A_U32 uPresentedVisibility;		// The count of visibility changes when the windows were last presented.
+
 	public:
+		WindowManager();
+
 		static bool GetGlobalWindowVisibility();
 		static void SetGlobalWindowVisibility(bool bVisibility);
 
 		void PresentAll();
+
+		/// <summary>
+		/// Checks whether the windows would look any different if they were presented again, because windows were added, released, shown or hidden, or a visible window is dirty. Only to be called from the invoking thread.
+		/// </summary>
+		bool IsUpdateDue() const;
 	};
 }
 
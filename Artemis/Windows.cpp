@@ -4,8 +4,178 @@
 #include "External.h"
 #include "GameManager.h"
 
-MainWindow::MainWindow() : IWindow("Main Window", true) {}
+MainWindow::MainWindow(_In_opt_ Artemis::IWindow* pLatencyWindow) : IWindow("Main Window", true), pLatencyWindow(pLatencyWindow) {}
 
 void MainWindow::Window() {
 	ImGui::Text("Artemis RT test 1.0");
-}
\ No newline at end of file
+
+	if (pLatencyWindow) {
+		bool bLatencyVisible = pLatencyWindow->GetWindowVisibility();
+		if (ImGui::Checkbox("Input latency", &bLatencyVisible))
+			pLatencyWindow->SetWindowVisibility(bLatencyVisible);
+	}
+}
+
+bool MainWindow::IsDirty() const { return false; }
+
+LatencyWindow::LatencyWindow() : IWindow("Input Latency", false), uSelected(0), szfBuckets(), bExported(false), bExportFailed(false), uPresentedCount(0) {}
+
+void LatencyWindow::Window() {
+	Artemis::InputLatency& refLatency = Artemis::Keybinds.GetLatency();
+	const std::vector<Artemis::BindingLatency>& refBindings = refLatency.GetBindings();
+	const Artemis::LatencyHistogram& refTotal = refLatency.GetTotal();
+	uPresentedCount = refTotal.uCount;
+
+	ImGui::Text(
+		"Input to present: %llu calls, %.1f us avg / %.1f us p50 / %.1f us p99 / %.1f us max, %llu dropped",
+		refTotal.uCount,
+		refTotal.GetAverage() / 1000.0,
+		refTotal.GetPercentile(0.5) / 1000.0,
+		refTotal.GetPercentile(0.99) / 1000.0,
+		refTotal.uMaximum / 1000.0,
+		refLatency.GetDroppedCount()
+	);
+
+	if (ImGui::Button("Reset")) {
+		refLatency.Reset();
+		uSelected = 0;
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Export")) {
+		bExported = refLatency.Export("InputLatency.csv");
+		bExportFailed = !bExported;
+	}
+	if (bExported) {
+		ImGui::SameLine();
+		ImGui::Text("Exported to InputLatency.csv.");
+	}
+	else if (bExportFailed) {
+		ImGui::SameLine();
+		ImGui::Text("Export failed.");
+	}
+	ImGui::Separator();
+
+	ImGui::Columns(7, "Latencies");
+	ImGui::Text("Keybind"); ImGui::NextColumn();
+	ImGui::Text("Key"); ImGui::NextColumn();
+	ImGui::Text("Calls"); ImGui::NextColumn();
+	ImGui::Text("Action avg (us)"); ImGui::NextColumn();
+	ImGui::Text("Present avg (us)"); ImGui::NextColumn();
+	ImGui::Text("Present p99 (us)"); ImGui::NextColumn();
+	ImGui::Text("Present max (us)"); ImGui::NextColumn();
+	ImGui::Separator();
+
+	for (A_U32 i = 0; i < static_cast<A_U32>(refBindings.size()); i++) {
+		const Artemis::BindingLatency& refBinding = refBindings[i];
+
+		ImGui::PushID(i);
+		if (ImGui::Selectable(refBinding.lpTypeName, uSelected == i, ImGuiSelectableFlags_SpanAllColumns)) uSelected = i;
+		ImGui::PopID();
+		ImGui::NextColumn();
+		ImGui::Text(
+			"%s%s%s%s0x%02X",
+			(refBinding.Modifiers & Artemis::KeyModifiers::Control) != Artemis::KeyModifiers::None ? "Ctrl+" : "",
+			(refBinding.Modifiers & Artemis::KeyModifiers::Shift) != Artemis::KeyModifiers::None ? "Shift+" : "",
+			(refBinding.Modifiers & Artemis::KeyModifiers::Alt) != Artemis::KeyModifiers::None ? "Alt+" : "",
+			(refBinding.Modifiers & Artemis::KeyModifiers::Windows) != Artemis::KeyModifiers::None ? "Win+" : "",
+			refBinding.uKey
+		);
+		ImGui::NextColumn();
+		ImGui::Text("%llu", refBinding.ToPresent.uCount); ImGui::NextColumn();
+		ImGui::Text("%.1f", refBinding.ToAction.GetAverage() / 1000.0); ImGui::NextColumn();
+		ImGui::Text("%.1f", refBinding.ToPresent.GetAverage() / 1000.0); ImGui::NextColumn();
+		ImGui::Text("%.1f", refBinding.ToPresent.GetPercentile(0.99) / 1000.0); ImGui::NextColumn();
+		ImGui::Text("%.1f", refBinding.ToPresent.uMaximum / 1000.0); ImGui::NextColumn();
+	}
+
+	ImGui::Columns(1);
+
+	if (uSelected < refBindings.size()) {
+		for (A_U32 i = 0; i < Artemis::LatencyHistogram::c_uBucketCount; i++)
+			szfBuckets[i] = static_cast<float>(refBindings[uSelected].ToPresent.szuBuckets[i]);
+
+		ImGui::Separator();
+		ImGui::PlotHistogram("##Histogram", szfBuckets, Artemis::LatencyHistogram::c_uBucketCount, 0, "Input to present, log scale", 0.0f, FLT_MAX, ImVec2(0.0f, 80.0f));
+	}
+}
+
+bool LatencyWindow::IsDirty() const { return Artemis::Keybinds.GetLatency().GetTotal().uCount != uPresentedCount; }
+
+#ifdef ARTEMIS_PROFILE
+ProfilerWindow::ProfilerWindow() : IWindow("Profiler", true) {}
+
+void ProfilerWindow::Window() {
+	Reports.clear();
+	Artemis::DrawManagers.QueryTimings(Reports);
+	Artemis::EventEntries.QueryTimings(Reports);
+	Artemis::Keybinds.QueryTimings(Reports);
+	Artemis::Windows.QueryTimings(Reports);
+	Artemis::KeepTopOffenders(Reports, 10);
+
+	Artemis::DrawStatistics Statistics = Artemis::DrawManagers.GetStatistics();
+	ImGui::Text("Shapes: %llu emitted, %llu culled", Statistics.uEmittedShapes, Statistics.uCulledShapes);
+
+	Artemis::EventSchedulerStatistics SchedulerStatistics = Artemis::EventEntries.GetStatistics();
+	ImGui::Text("Event entries: %u of %u due (%u max)", SchedulerStatistics.uEvaluated, SchedulerStatistics.uRegistered, SchedulerStatistics.uMaxEvaluated);
+
+	Artemis::KeybindStatistics KeybindStatistics = Artemis::Keybinds.GetStatistics();
+	A_U64 uKeybindTime = KeybindStatistics.uBusyTime + KeybindStatistics.uIdleTime;
+	ImGui::Text(
+		"Keybinds: %llu presses, %.1f us avg / %.1f us max latency, thread busy %.3f%%",
+		KeybindStatistics.uPresses,
+		KeybindStatistics.uPresses ? KeybindStatistics.uTotalLatency / KeybindStatistics.uPresses / 1000.0 : 0.0,
+		KeybindStatistics.uMaxLatency / 1000.0,
+		uKeybindTime ? 100.0 * KeybindStatistics.uBusyTime / uKeybindTime : 0.0
+	);
+
+	Artemis::WatchStatistics WatchStatistics = Artemis::Watches.GetStatistics();
+	ImGui::Text("Watches: %llu sampled in %llu reads, %llu failed", WatchStatistics.uSampledWatches, WatchStatistics.uReads, WatchStatistics.uFailedReads);
+
+	Artemis::EventQueueStatistics QueueStatistics = Artemis::AsyncEvents.GetStatistics();
+	ImGui::Text("Async events: %u queued (%u max), %llu dropped, %llu coalesced", QueueStatistics.uDepth, QueueStatistics.uMaxDepth, QueueStatistics.uDropped, QueueStatistics.uCoalesced);
+
+	Artemis::FrameThrottleStatistics ThrottleStatistics = Artemis::Throttle.GetStatistics();
+	ImGui::Text("UI: %llu frames built, %llu replayed, at most %u Hz", ThrottleStatistics.uBuiltFrames, ThrottleStatistics.uReplayedFrames, Artemis::Throttle.GetUpdateRate());
+	ImGui::Separator();
+
+	Phases.clear();
+	Artemis::FramePhases.QueryTimings(Phases);
+
+	ImGui::Columns(5, "Phases");
+	ImGui::Text("Frame phase"); ImGui::NextColumn();
+	ImGui::Text("Frames"); ImGui::NextColumn();
+	ImGui::Text("Min (ns)"); ImGui::NextColumn();
+	ImGui::Text("Avg (ns)"); ImGui::NextColumn();
+	ImGui::Text("P99 (ns)"); ImGui::NextColumn();
+	ImGui::Separator();
+
+	for (const Artemis::TimingReport& refPhase : Phases) {
+		ImGui::Text("%s", refPhase.lpTypeName); ImGui::NextColumn();
+		ImGui::Text("%llu", refPhase.Statistics.uCalls); ImGui::NextColumn();
+		ImGui::Text("%.0f", refPhase.Statistics.fMinimum); ImGui::NextColumn();
+		ImGui::Text("%.0f", refPhase.Statistics.fAverage); ImGui::NextColumn();
+		ImGui::Text("%.0f", refPhase.Statistics.fP99); ImGui::NextColumn();
+	}
+
+	ImGui::Columns(1);
+	ImGui::Separator();
+
+	ImGui::Columns(5, "Timings");
+	ImGui::Text("Type"); ImGui::NextColumn();
+	ImGui::Text("Calls"); ImGui::NextColumn();
+	ImGui::Text("Min (ns)"); ImGui::NextColumn();
+	ImGui::Text("Avg (ns)"); ImGui::NextColumn();
+	ImGui::Text("P99 (ns)"); ImGui::NextColumn();
+	ImGui::Separator();
+
+	for (const Artemis::TimingReport& refReport : Reports) {
+		ImGui::Text("%s", refReport.lpTypeName); ImGui::NextColumn();
+		ImGui::Text("%llu", refReport.Statistics.uCalls); ImGui::NextColumn();
+		ImGui::Text("%.0f", refReport.Statistics.fMinimum); ImGui::NextColumn();
+		ImGui::Text("%.0f", refReport.Statistics.fAverage); ImGui::NextColumn();
+		ImGui::Text("%.0f", refReport.Statistics.fP99); ImGui::NextColumn();
+	}
+
+	ImGui::Columns(1);
+}
+#endif // ARTEMIS_PROFILE
\ No newline at end of file
@@ -1,10 +1,40 @@
 #pragma once
 
+#include "InputLatency.h"
 #include "WindowManager.h"
 
 class MainWindow : public Artemis::IWindow {
+	Artemis::IWindow* pLatencyWindow; // Shown and hidden from here, if there is one. Only released together with this window.
+
+public:
+	MainWindow(_In_opt_ Artemis::IWindow* pLatencyWindow);
+
+	virtual void Window() final;
+	virtual bool IsDirty() const final;
+};
+
+class LatencyWindow : public Artemis::IWindow {
+	A_U32 uSelected; // The index of the keybind whose histogram is shown.
+	float szfBuckets[Artemis::LatencyHistogram::c_uBucketCount];
+	bool bExported;
+	bool bExportFailed;
+	A_U64 uPresentedCount; // The number of latencies that were shown when the window was last presented.
+
+public:
+	LatencyWindow();
+
+	virtual void Window() final;
+	virtual bool IsDirty() const final;
+};
+
+#ifdef ARTEMIS_PROFILE
+class ProfilerWindow : public Artemis::IWindow {
+	std::vector<Artemis::TimingReport> Reports;
+	std::vector<Artemis::TimingReport> Phases;
+
 public:
-	MainWindow();
+	ProfilerWindow();
 
 	virtual void Window() final;
-};
\ No newline at end of file
+};
+#endif // ARTEMIS_PROFILE
\ No newline at end of file
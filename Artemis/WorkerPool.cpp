@@ -0,0 +1,61 @@
+#include "WorkerPool.h"
+
+namespace Artemis {
+	WorkerPool::WorkerPool(_In_ A_U32 uWorkerCount) : uJobCount(0), uBatch(0), uBusyWorkers(0), bStopping(false), uNextJob(0) {
+		if (!uWorkerCount) uWorkerCount = 1;
+
+		Workers.reserve(uWorkerCount);
+		for (A_U32 i = 0; i < uWorkerCount; i++)
+			Workers.emplace_back(&WorkerPool::WorkerMain, this);
+	}
+
+	WorkerPool::~WorkerPool() {
+		Wait();
+
+		bStopping.store(true);
+		uBatch.fetch_add(1);
+		uBatch.notify_all();
+
+		for (std::thread& refWorker : Workers)
+			refWorker.join();
+	}
+
+	void WorkerPool::WorkerMain() {
+		A_U64 uSeenBatch = 0;
+
+		while (true) {
+			uBatch.wait(uSeenBatch);
+			if (bStopping.load()) return;
+
+			// The next batch is only handed out once this worker is done with this one, so no batch is skipped.
+			uSeenBatch = uBatch.load();
+			A_U32 uCount = uJobCount;
+
+			for (A_U32 uJob; (uJob = uNextJob.fetch_add(1)) < uCount;)
+				fnJob(uJob);
+
+			if (uBusyWorkers.fetch_sub(1) == 1) uBusyWorkers.notify_all();
+		}
+	}
+
+	void WorkerPool::Dispatch(_In_ A_U32 uJobCount, _In_ std::function<void(A_U32)> fnJob) {
+		if (!uJobCount) return;
+
+		Wait();
+
+		this->fnJob = std::move(fnJob);
+		this->uJobCount = uJobCount;
+		uNextJob.store(0);
+		uBusyWorkers.store(static_cast<A_U32>(Workers.size()));
+
+		uBatch.fetch_add(1);
+		uBatch.notify_all();
+	}
+
+	void WorkerPool::Wait() {
+		for (A_U32 uBusy; (uBusy = uBusyWorkers.load()) != 0;)
+			uBusyWorkers.wait(uBusy);
+	}
+
+	A_U32 WorkerPool::GetWorkerCount() const noexcept { return static_cast<A_U32>(Workers.size()); }
+}
@@ -0,0 +1,51 @@
+#ifndef __ARTEMIS_WORKER_POOL_H__
+#define __ARTEMIS_WORKER_POOL_H__
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <Aurora/Definitions.h>
+
+#include "Definitions.h"
+
+namespace Artemis {
+	/// <summary>
+	/// <para>A fixed set of threads that run batches of indexed jobs.</para>
+	/// <para>Dispatch hands out the job indices of a batch to the workers and returns right away. Wait blocks until every job of the batch has finished.</para>
+	/// <para>Only one batch runs at a time, and Dispatch and Wait must be called from the same thread.</para>
+	/// </summary>
+	class ARTEMIS_API WorkerPool {
+		std::vector<std::thread> Workers;
+
+		std::function<void(A_U32)> fnJob;
+		A_U32 uJobCount;
+
+		std::atomic<A_U64> uBatch;			// Bumped to hand a batch to the workers, which sleep on it in between.
+		std::atomic<A_U32> uBusyWorkers;	// The workers that have not run out of jobs in the current batch yet. Every worker takes part in every batch, so the batch is only replaced once none of them can still be reading it.
+		std::atomic<bool> bStopping;
+
+		std::atomic<A_U32> uNextJob;
+
+		void WorkerMain();
+
+	public:
+		explicit WorkerPool(_In_ A_U32 uWorkerCount);
+		~WorkerPool();
+
+		WorkerPool(const WorkerPool&) = delete;
+		WorkerPool& operator=(const WorkerPool&) = delete;
+
+		/// <summary>
+		/// Waits for the previous batch and starts running fnJob(0) to fnJob(uJobCount - 1) on the workers.
+		/// </summary>
+		void Dispatch(_In_ A_U32 uJobCount, _In_ std::function<void(A_U32)> fnJob);
+
+		void Wait();
+
+		A_U32 GetWorkerCount() const noexcept;
+	};
+}
+
+#endif // !__ARTEMIS_WORKER_POOL_H__
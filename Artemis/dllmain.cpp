@@ -28,10 +28,13 @@ const char* const lpszAsciiArt[13] = {
 		"<------------------------------------------------------------------------------------------------------>"
 };
 
-static bool bRunning = true;
+static std::atomic<bool> bRunning = true;
 static PresentHook* pHook = nullptr;
 
-ARTEMIS_API void Artemis::Exit() { bRunning = false; }
+ARTEMIS_API void Artemis::Exit() {
+	bRunning = false;
+	Keybinds.Interrupt();
+}
 
 void LogBasicInformation(const char* lpSender, const Aurora::ProcessInfo& CurrentProcess) {
 	Log.LogInfo(lpSender, "Welcome to Artemis!");
@@ -58,37 +61,38 @@ DWORD APIENTRY Main(HMODULE hModule) {
 
 	LogBasicInformation(__FUNCTION__, Aurora::GetCurrentProcessInfo());
 
-	if (Keybinds.Add(new ExitKeybind()) == INVALID_INDEX) {
+	if (!Keybinds.Add(new ExitKeybind()).IsValid()) {
 		Log.LogError(__FUNCTION__, "Exit keybind could not be added.");
 		bRunning = false;
 	}
 	else
 		Log.LogSuccess(__FUNCTION__, "Successfully registered the exit keybind.");
 
-	if (Windows.Add(new MainWindow()) == INVALID_INDEX)
-		Log.LogError(__FUNCTION__, "Main window could not be added.");
-	else
-		Log.LogSuccess(__FUNCTION__, "Successfully registered the main window.");
-
-	if (EventEntries.Add(new EnterMainMenuEventEntry()) == INVALID_INDEX)
-		Log.LogError(__FUNCTION__, "Enter main menu event entry could not be added.");
+	// Hidden until it is shown from the main window.
+	LatencyWindow* pLatencyWindow = new LatencyWindow();
+	if (!Windows.Add(pLatencyWindow).IsValid()) {
+		Log.LogError(__FUNCTION__, "Latency window could not be added.");
+		pLatencyWindow = nullptr;
+	}
 	else
-		Log.LogSuccess(__FUNCTION__, "Successfully registered the enter main menu event.");
+		Log.LogSuccess(__FUNCTION__, "Successfully registered the latency window.");
 
-	if (EventEntries.Add(new EnterCustomGameLobbyEventEntry()) == INVALID_INDEX)
-		Log.LogError(__FUNCTION__, "Enter custom game lobby event entry could not be added.");
+	if (!Windows.Add(new MainWindow(pLatencyWindow)).IsValid())
+		Log.LogError(__FUNCTION__, "Main window could not be added.");
 	else
-		Log.LogSuccess(__FUNCTION__, "Successfully registered the enter custom game event.");
+		Log.LogSuccess(__FUNCTION__, "Successfully registered the main window.");
 
-	if (EventEntries.Add(new EnterPickPhaseEventEntry()) == INVALID_INDEX)
-		Log.LogError(__FUNCTION__, "Enter pick phase event entry could not be added.");
+#ifdef ARTEMIS_PROFILE
+	if (!Windows.Add(new ProfilerWindow()).IsValid())
+		Log.LogError(__FUNCTION__, "Profiler window could not be added.");
 	else
-		Log.LogSuccess(__FUNCTION__, "Successfully registered the enter pick phase event.");
+		Log.LogSuccess(__FUNCTION__, "Successfully registered the profiler window.");
+#endif // ARTEMIS_PROFILE
 
-	if (EventEntries.Add(new EnterGameEventEntry()) == INVALID_INDEX)
-		Log.LogError(__FUNCTION__, "Enter game event entry could not be added.");
+	if (!EventEntries.Add(new GameStateEventEntry()).IsValid())
+		Log.LogError(__FUNCTION__, "Game state event entry could not be added.");
 	else
-		Log.LogSuccess(__FUNCTION__, "Successfully registered the enter game event.");
+		Log.LogSuccess(__FUNCTION__, "Successfully registered the game state events.");
 
 	MH_STATUS status = MH_Initialize();
 	if (status != MH_OK) {
@@ -101,8 +105,25 @@ DWORD APIENTRY Main(HMODULE hModule) {
 		pHook->Enable();
 	}
 
-	while (bRunning)
+	Watches.Start();
+	AsyncEvents.Start(std::thread::hardware_concurrency() >= 8 ? 2 : 0);
+
+	// Key transitions are posted by the window procedure of the present hook, so the thread sleeps until there is input to handle, or keybinds to compile and release.
+	while (bRunning) {
 		Keybinds.Invoke();
+		Keybinds.Quiesce();
+
+		FrameArena::Current().Reset();
+
+		if (bRunning)
+			Keybinds.Wait();
+	}
+
+	Watches.Stop();
+	AsyncEvents.Stop();
+
+	// Joins the recording workers while the module is still loaded, rather than under the loader lock when the collection is destroyed.
+	DrawManagers.SetParallelRecording(0);
 
 	if (pHook)
 		pHook->Release();
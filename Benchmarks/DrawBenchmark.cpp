@@ -0,0 +1,98 @@
+// Measures how fast the draw path writes vertices, comparing shapes added one at a time through ImDrawList with the same shapes added as batches.
+
+#include "pch.h"
+
+#include <span>
+
+#include <benchmark/benchmark.h>
+
+#include "DrawManager.h"
+#include "FrameArena.h"
+#include "Manager.inl"
+#include "ShapeWorkload.h"
+
+namespace {
+	class WorkloadDraw : public Artemis::IDraw {
+		const Artemis::ShapeWorkload& refWorkload;
+		bool bBatched;
+
+	public:
+		WorkloadDraw(_In_ const Artemis::ShapeWorkload& refWorkload, _In_ bool bBatched) noexcept : refWorkload(refWorkload), bBatched(bBatched) {}
+
+		void Draw() override {
+			if (bBatched) {
+				AddDraw(std::span<const Aurora::Line>(refWorkload.Lines));
+				AddDraw(std::span<const Aurora::Rectangle>(refWorkload.Rectangles));
+				AddDraw(std::span<const Aurora::Triangle>(refWorkload.Triangles));
+				AddDraw(std::span<const Aurora::Circle>(refWorkload.Circles));
+				return;
+			}
+
+			for (const Aurora::Line& refLine : refWorkload.Lines) AddDraw(refLine);
+			for (const Aurora::Rectangle& refRectangle : refWorkload.Rectangles) AddDraw(refRectangle);
+			for (const Aurora::Triangle& refTriangle : refWorkload.Triangles) AddDraw(refTriangle);
+			for (const Aurora::Circle& refCircle : refWorkload.Circles) AddDraw(refCircle);
+		}
+	};
+
+	// An ImGui context of the benchmark's own, without a window or a renderer.
+	class Context {
+		ImGuiContext* pContext;
+
+	public:
+		explicit Context(_In_ bool bAntiAliased) : pContext(ImGui::CreateContext()) {
+			ImGuiIO& refIO = ImGui::GetIO();
+			refIO.DisplaySize = ImVec2(1920.0F, 1080.0F);
+			refIO.IniFilename = nullptr;
+
+			unsigned char* lpPixels;
+			int nWidth, nHeight;
+			refIO.Fonts->GetTexDataAsAlpha8(&lpPixels, &nWidth, &nHeight);
+
+			ImGui::GetStyle().AntiAliasedLines = bAntiAliased;
+			ImGui::GetStyle().AntiAliasedFill = bAntiAliased;
+		}
+
+		~Context() { ImGui::DestroyContext(pContext); }
+
+		// Returns the number of vertices the frame rendered.
+		A_U64 Frame(_Inout_ Artemis::IDraw& refDraw) {
+			ImGui::GetIO().DeltaTime = 1.0F / 60.0F;
+
+			ImGui::NewFrame();
+			refDraw.Present(ImGui::GetForegroundDrawList());
+			ImGui::Render();
+
+			Artemis::FrameArena::Current().Reset();
+			return static_cast<A_U64>(ImGui::GetDrawData()->TotalVtxCount);
+		}
+	};
+
+	void Measure(benchmark::State& refState, _In_ bool bBatched) {
+		Artemis::ShapeWorkload Shapes(static_cast<A_U32>(refState.range(0)), { 0.0F, 0.0F, 1919.0F, 1079.0F });
+		WorkloadDraw Draw(Shapes, bBatched);
+		Context Backend(refState.range(1) != 0);
+
+		// Lets the draw list and arena buffers grow to their steady-state size.
+		for (A_U32 i = 0; i < 16; i++)
+			Backend.Frame(Draw);
+
+		A_U64 uVertices = 0;
+		for (auto _ : refState)
+			uVertices += Backend.Frame(Draw);
+
+		refState.SetItemsProcessed(refState.iterations() * refState.range(0));
+		refState.counters["vertices/us"] = benchmark::Counter(static_cast<double>(uVertices) / 1e6, benchmark::Counter::kIsRate);
+	}
+
+	void SingleShapes(benchmark::State& refState) { Measure(refState, false); }
+	void BatchedShapes(benchmark::State& refState) { Measure(refState, true); }
+}
+
+template class Artemis::Manager<Artemis::IDraw>;
+
+// The second argument turns anti-aliasing on, which ImGui enables by default.
+BENCHMARK(SingleShapes)->ArgsProduct({ { 1024, 16384 }, { 0, 1 } });
+BENCHMARK(BatchedShapes)->ArgsProduct({ { 1024, 16384 }, { 0, 1 } });
+
+BENCHMARK_MAIN();
\ No newline at end of file
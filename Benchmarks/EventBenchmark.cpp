@@ -0,0 +1,58 @@
+// Measures the cost of Aurora::Event::Invoke at 1, 8 and 64 subscribers, comparing the packed delegates with the std::function slots events were stored in before.
+
+#include <Aurora/Events.h>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+	struct CounterEventArgs {
+		A_U64 uValue;
+	};
+
+	// The previous storage: a std::function in each of the MAX_INVOKE slots, all of which are visited on every invocation.
+	class SlotEvent {
+		Aurora::Function<A_VOID(_In_opt_ A_LPVOID lpSender, _In_opt_ const CounterEventArgs* lpEventArgs)> lpszfnEventHandlers[MAX_INVOKE];
+
+	public:
+		A_VOID Invoke(_In_opt_ A_LPVOID lpSender, _In_opt_ const CounterEventArgs* lpArgs) const {
+			for (A_I32 i = 0; i < MAX_INVOKE; i++)
+				if (lpszfnEventHandlers[i] != nullptr)
+					lpszfnEventHandlers[i](lpSender, lpArgs);
+		}
+
+		A_VOID operator+=(_In_ Aurora::Function<A_VOID(_In_opt_ A_LPVOID lpSender, _In_opt_ const CounterEventArgs* lpEventArgs)> lpfnEventHandler) {
+			for (A_I32 i = 0; i < MAX_INVOKE; i++)
+				if (lpszfnEventHandlers[i] == nullptr) {
+					lpszfnEventHandlers[i] = lpfnEventHandler;
+					break;
+				}
+		}
+	};
+
+	volatile A_U64 uTotal;
+
+	A_VOID OnCounter(_In_opt_ A_LPVOID, _In_opt_ const CounterEventArgs* lpArgs) { uTotal = uTotal + lpArgs->uValue; }
+
+	// Arguments: the number of subscribers, and whether they are lambdas with a capture rather than function pointers.
+	template<class TEvent>
+	void Invoke(benchmark::State& refState) {
+		A_U32 uSubscriberCount = static_cast<A_U32>(refState.range(0));
+
+		TEvent Event;
+		for (A_U32 i = 0; i < uSubscriberCount; i++) {
+			if (refState.range(1)) Event += [i](_In_opt_ A_LPVOID, _In_opt_ const CounterEventArgs* lpArgs) { uTotal = uTotal + lpArgs->uValue + i; };
+			else Event += &OnCounter;
+		}
+
+		const CounterEventArgs Args = { 1 };
+		for (auto _ : refState)
+			Event.Invoke(nullptr, &Args);
+
+		refState.SetItemsProcessed(refState.iterations() * uSubscriberCount);
+	}
+}
+
+BENCHMARK_TEMPLATE(Invoke, SlotEvent)->ArgsProduct({ { 1, 8, MAX_INVOKE }, { 0, 1 } });
+BENCHMARK_TEMPLATE(Invoke, Aurora::Event<CounterEventArgs>)->ArgsProduct({ { 1, 8, MAX_INVOKE }, { 0, 1 } });
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,91 @@
+// Pushes whole frames of synthetic draws through DrawManagerCollection::PresentAll on a headless ImGui context, the way the present hook does,
+// and reports the time per shape, the vertices per frame and the allocations per frame.
+
+#include "pch.h"
+
+#include <span>
+
+#include <benchmark/benchmark.h>
+
+#include "DrawManager.h"
+#include "HeadlessBackend.h"
+#include "Manager.inl"
+#include "ShapeWorkload.h"
+
+namespace {
+	constexpr A_FL32 c_fDisplayWidth = 1920.0F;
+	constexpr A_FL32 c_fDisplayHeight = 1080.0F;
+
+	// Shapes spread over twice the size of the display in each direction, so about three quarters of them are culled, and a column of changing numbers.
+	class LayerDraw final : public Artemis::IDraw {
+		Artemis::ShapeWorkload Shapes;
+		A_U32 uLabelCount;
+		A_U32 uFrame;
+
+	public:
+		LayerDraw(_In_ A_U32 uShapeCount, _In_ bool bForeground) :
+			IDraw(bForeground),
+			Shapes(uShapeCount, { -c_fDisplayWidth / 2.0F, -c_fDisplayHeight / 2.0F, c_fDisplayWidth * 1.5F, c_fDisplayHeight * 1.5F }),
+			uLabelCount(uShapeCount / 64),
+			uFrame(0)
+		{}
+
+		void Draw() override {
+			AddDraw(std::span<const Aurora::Line>(Shapes.Lines));
+			AddDraw(std::span<const Aurora::Rectangle>(Shapes.Rectangles));
+			AddDraw(std::span<const Aurora::Triangle>(Shapes.Triangles));
+			AddDraw(std::span<const Aurora::Circle>(Shapes.Circles));
+
+			uFrame++;
+			for (A_U32 i = 0; i < uLabelCount; i++)
+				AddNumber(Aurora::Point(8, static_cast<A_I32>(8 + (i * 16) % 1000)), static_cast<A_I64>(uFrame * 31 + i), Aurora::RGBA(255.0F, 255.0F));
+		}
+	};
+
+	// Arguments: the number of layers, the shapes drawn by each layer, and the recording workers, where 0 presents serially.
+	void PresentAll(benchmark::State& refState) {
+		A_U32 uLayerCount = static_cast<A_U32>(refState.range(0));
+		A_U32 uShapeCount = static_cast<A_U32>(refState.range(1));
+
+		Artemis::HeadlessBackend Backend(ImVec2(c_fDisplayWidth, c_fDisplayHeight));
+
+		Artemis::DrawManagerCollection Layers;
+		for (A_U32 i = 0; i < uLayerCount; i++) {
+			Artemis::DrawManager* pLayer = Layers.Get(Layers.AddNew(nullptr, static_cast<A_I32>(i)));
+			pLayer->Emplace<LayerDraw>(uShapeCount, i & 1);
+		}
+
+		Layers.SetParallelRecording(static_cast<A_U32>(refState.range(2)));
+
+		// Lets the draw lists, the frame arena and the glyph caches grow to their steady-state size.
+		for (A_U32 i = 0; i < 16; i++)
+			Backend.Frame(Layers);
+
+		A_U64 uShapes = 0, uVertices = 0;
+		A_U64 uFirstAllocation = Artemis::HeadlessBackend::GetAllocationCount();
+
+		for (auto _ : refState) {
+			ImDrawData* pDrawData = Backend.Frame(Layers);
+
+			Artemis::DrawStatistics Statistics = Layers.GetStatistics();
+			uShapes += Statistics.uCulledShapes + Statistics.uEmittedShapes;
+			uVertices += static_cast<A_U64>(pDrawData->TotalVtxCount);
+		}
+
+		A_U64 uAllocations = Artemis::HeadlessBackend::GetAllocationCount() - uFirstAllocation;
+
+		// Parallel recording draws one frame late, so its workers have to finish before the layers go away.
+		Layers.SetParallelRecording(0);
+
+		refState.counters["time/shape"] = benchmark::Counter(static_cast<double>(uShapes), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+		refState.counters["shapes/frame"] = benchmark::Counter(static_cast<double>(uShapes), benchmark::Counter::kAvgIterations);
+		refState.counters["vertices/frame"] = benchmark::Counter(static_cast<double>(uVertices), benchmark::Counter::kAvgIterations);
+		refState.counters["allocations/frame"] = benchmark::Counter(static_cast<double>(uAllocations), benchmark::Counter::kAvgIterations);
+	}
+}
+
+template class Artemis::Manager<Artemis::IDraw>;
+
+BENCHMARK(PresentAll)->ArgsProduct({ { 1, 8 }, { 256, 4096 }, { 0, 2 } })->UseRealTime();
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "pch.h"
+#include "HeadlessBackend.h"
+
+#include <cstdlib>
+
+#include "FrameArena.h"
+
+namespace Artemis {
+	std::atomic<A_U64> HeadlessBackend::s_uAllocations;
+
+	void* HeadlessBackend::Allocate(_In_ size_t uSize, _In_opt_ void* lpUserData) {
+		s_uAllocations.fetch_add(1, std::memory_order_relaxed);
+		return malloc(uSize);
+	}
+
+	void HeadlessBackend::Free(_In_opt_ void* lpMemory, _In_opt_ void* lpUserData) { free(lpMemory); }
+
+	HeadlessBackend::HeadlessBackend(_In_ const ImVec2& vDisplaySize) : pPreviousContext(ImGui::GetCurrentContext()) {
+		// The default allocator uses malloc and free as well, so memory allocated before the switch can still be freed.
+		ImGui::SetAllocatorFunctions(&HeadlessBackend::Allocate, &HeadlessBackend::Free);
+
+		pContext = ImGui::CreateContext();
+		ImGui::SetCurrentContext(pContext);
+
+		ImGuiIO& refIO = ImGui::GetIO();
+		refIO.DisplaySize = vDisplaySize;
+		refIO.IniFilename = nullptr;
+		refIO.LogFilename = nullptr;
+
+		// Nothing samples the font texture, but NewFrame requires a built atlas.
+		unsigned char* lpPixels;
+		int nWidth, nHeight;
+		refIO.Fonts->GetTexDataAsAlpha8(&lpPixels, &nWidth, &nHeight);
+		refIO.Fonts->TexID = nullptr;
+	}
+
+	HeadlessBackend::~HeadlessBackend() {
+		ImGui::DestroyContext(pContext);
+		ImGui::SetCurrentContext(pPreviousContext);
+		ImGui::SetAllocatorFunctions(
+			[](size_t uSize, void*) { return malloc(uSize); },
+			[](void* lpMemory, void*) { free(lpMemory); }
+		);
+	}
+
+	ImDrawData* HeadlessBackend::Frame(_Inout_ DrawManagerCollection& refCollection, _In_ A_FL32 fDeltaTime) {
+		ImGui::SetCurrentContext(pContext);
+		ImGui::GetIO().DeltaTime = fDeltaTime;
+
+		ImGui::NewFrame();
+		refCollection.PresentAll(ImGui::GetForegroundDrawList(), ImGui::GetBackgroundDrawList());
+		ImGui::EndFrame();
+		ImGui::Render();
+
+		refCollection.Quiesce();
+		FrameArena::Current().Reset();
+
+		return ImGui::GetDrawData();
+	}
+
+	A_U64 HeadlessBackend::GetAllocationCount() noexcept { return s_uAllocations.load(std::memory_order_relaxed); }
+}
\ No newline at end of file
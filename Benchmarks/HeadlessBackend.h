@@ -0,0 +1,44 @@
+#ifndef __ARTEMIS_HEADLESS_BACKEND_H__
+#define __ARTEMIS_HEADLESS_BACKEND_H__
+
+#include <atomic>
+
+#include <ImGui/imgui.h>
+
+#include "DrawManager.h"
+
+namespace Artemis {
+	/// <summary>
+	/// <para>Drives an ImGui context of its own without a window or a GPU, so that the draw path can be measured outside of the game.</para>
+	/// <para>Frames run through NewFrame, DrawManagerCollection::PresentAll and Render in the order the present hook uses, and leave their output in ImDrawData.</para>
+	/// <para>While it exists it replaces the current ImGui context and the ImGui allocator.</para>
+	/// </summary>
+	class HeadlessBackend {
+		static std::atomic<A_U64> s_uAllocations;
+
+		ImGuiContext* pContext;
+		ImGuiContext* pPreviousContext;
+
+		static void* Allocate(_In_ size_t uSize, _In_opt_ void* lpUserData);
+		static void Free(_In_opt_ void* lpMemory, _In_opt_ void* lpUserData);
+
+	public:
+		explicit HeadlessBackend(_In_ const ImVec2& vDisplaySize);
+		~HeadlessBackend();
+
+		HeadlessBackend(const HeadlessBackend&) = delete;
+		HeadlessBackend& operator=(const HeadlessBackend&) = delete;
+
+		/// <summary>
+		/// Runs a single frame of refCollection and returns the draw data it rendered, which stays valid until the next frame.
+		/// </summary>
+		ImDrawData* Frame(_Inout_ DrawManagerCollection& refCollection, _In_ A_FL32 fDeltaTime = 1.0F / 60.0F);
+
+		/// <summary>
+		/// Gets the number of allocations made through the ImGui allocator since the backend was created.
+		/// </summary>
+		static A_U64 GetAllocationCount() noexcept;
+	};
+}
+
+#endif // !__ARTEMIS_HEADLESS_BACKEND_H__
\ No newline at end of file
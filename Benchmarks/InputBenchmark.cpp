@@ -0,0 +1,159 @@
+// Compares the keybind thread blocking on the input queue with the loop it replaced, which polled the state of every bound key without ever waiting.
+// A producer presses and releases a key once per interval, like a player would, and the consumer thread acts on each press.
+// Reports the CPU time the consumer thread used as a share of the wall time, and the time from posting a press to acting on it.
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <time.h>
+#endif // _WIN32
+
+#include <benchmark/benchmark.h>
+
+#include "InputQueue.h"
+
+namespace {
+	constexpr A_U32 c_uKey = 'A';
+
+	A_U64 GetTimestamp() noexcept { return static_cast<A_U64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()); }
+
+	// The CPU time the calling thread has used, in nanoseconds.
+	A_U64 GetThreadTime() noexcept {
+#ifdef _WIN32
+		FILETIME Creation, Exit, Kernel, User;
+		GetThreadTimes(GetCurrentThread(), &Creation, &Exit, &Kernel, &User);
+		return ((static_cast<A_U64>(Kernel.dwHighDateTime) << 32 | Kernel.dwLowDateTime) + (static_cast<A_U64>(User.dwHighDateTime) << 32 | User.dwLowDateTime)) * 100;
+#else
+		timespec Time;
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &Time);
+		return static_cast<A_U64>(Time.tv_sec) * 1000000000 + static_cast<A_U64>(Time.tv_nsec);
+#endif // _WIN32
+	}
+
+	// Filled in by the consumer thread, and read once it has been joined.
+	struct ConsumerResult {
+		std::atomic<A_U64> uActions;
+		A_U64 uTotalLatency;
+		A_U64 uMaxLatency;
+		A_U64 uThreadTime;
+
+		ConsumerResult() noexcept : uActions(0), uTotalLatency(0), uMaxLatency(0), uThreadTime(0) {}
+
+		void Act(_In_ A_U64 uInputTime) noexcept {
+			A_U64 uLatency = GetTimestamp() - uInputTime;
+			uTotalLatency += uLatency;
+			if (uLatency > uMaxLatency) uMaxLatency = uLatency;
+			uActions.fetch_add(1, std::memory_order_release);
+		}
+	};
+
+	// Presses the key once per iteration and releases it once the consumer has acted on the press, so every press is measured on its own. Returns the wall time it took.
+	template<class Post>
+	A_U64 Produce(benchmark::State& refState, _In_ const ConsumerResult& refResult, _In_ Post&& fnPost) {
+		std::chrono::microseconds Interval(refState.range(0));
+
+		A_U64 uWallStart = GetTimestamp();
+		A_U64 uPresses = 0;
+
+		for (auto _ : refState) {
+			std::this_thread::sleep_for(Interval);
+
+			fnPost(true);
+
+			uPresses++;
+			while (refResult.uActions.load(std::memory_order_acquire) < uPresses)
+				std::this_thread::yield();
+
+			fnPost(false);
+		}
+
+		return GetTimestamp() - uWallStart;
+	}
+
+	void Report(benchmark::State& refState, _In_ const ConsumerResult& refResult, _In_ A_U64 uWallTime) {
+		A_U64 uActions = refResult.uActions.load(std::memory_order_relaxed);
+
+		refState.counters["consumer CPU %"] = uWallTime ? 100.0 * static_cast<double>(refResult.uThreadTime) / static_cast<double>(uWallTime) : 0.0;
+		refState.counters["latency (us)"] = uActions ? static_cast<double>(refResult.uTotalLatency) / static_cast<double>(uActions) / 1000.0 : 0.0;
+		refState.counters["max latency (us)"] = static_cast<double>(refResult.uMaxLatency) / 1000.0;
+	}
+
+	// The keybind thread as it is now: it blocks in Wait until a transition is posted.
+	void EventDriven(benchmark::State& refState) {
+		Artemis::InputQueue Queue;
+		ConsumerResult Result;
+		std::atomic<bool> bRunning = true;
+
+		std::thread Consumer([&]() {
+			A_U64 uThreadStart = GetThreadTime();
+
+			Artemis::InputEvent Event;
+			while (bRunning.load()) {
+				while (Queue.Pop(Event))
+					if (Event.uKey == c_uKey && Event.bDown)
+						Result.Act(Event.uTimestamp);
+
+				Queue.Wait();
+			}
+
+			Result.uThreadTime = GetThreadTime() - uThreadStart;
+		});
+
+		A_U64 uWallTime = Produce(refState, Result, [&](_In_ bool bDown) { Queue.Push({ GetTimestamp(), c_uKey, bDown }); });
+
+		bRunning.store(false);
+		Queue.Interrupt();
+		Consumer.join();
+
+		Report(refState, Result, uWallTime);
+	}
+
+	// The loop the keybind thread used to run: it reads the state of every bound key, the way it called GetAsyncKeyState, over and over.
+	void Polling(benchmark::State& refState) {
+		A_U32 uKeybindCount = static_cast<A_U32>(refState.range(1));
+
+		std::atomic<bool> szbKeys[256] = {};
+		std::atomic<A_U64> uPressTime = 0;
+		ConsumerResult Result;
+		std::atomic<bool> bRunning = true;
+
+		std::thread Consumer([&]() {
+			A_U64 uThreadStart = GetThreadTime();
+
+			bool bWasDown = false;
+			while (bRunning.load(std::memory_order_relaxed)) {
+				for (A_U32 i = 0; i < uKeybindCount; i++) {
+					A_U32 uKey = c_uKey + i;
+					bool bDown = szbKeys[uKey].load(std::memory_order_acquire);
+
+					if (uKey == c_uKey) {
+						if (bDown && !bWasDown) Result.Act(uPressTime.load(std::memory_order_relaxed));
+						bWasDown = bDown;
+					}
+				}
+			}
+
+			Result.uThreadTime = GetThreadTime() - uThreadStart;
+		});
+
+		A_U64 uWallTime = Produce(refState, Result, [&](_In_ bool bDown) {
+			if (bDown) uPressTime.store(GetTimestamp(), std::memory_order_relaxed);
+			szbKeys[c_uKey].store(bDown, std::memory_order_release);
+		});
+
+		bRunning.store(false);
+		Consumer.join();
+
+		Report(refState, Result, uWallTime);
+	}
+}
+
+// Arguments: the interval between presses in microseconds, and for polling, the number of bound keys it reads.
+BENCHMARK(EventDriven)->Arg(1000)->Iterations(200)->UseRealTime();
+BENCHMARK(Polling)->Args({ 1000, 16 })->Iterations(200)->UseRealTime();
+
+BENCHMARK_MAIN();
\ No newline at end of file
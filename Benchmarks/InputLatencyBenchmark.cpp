@@ -0,0 +1,143 @@
+// Drives the input latency instrumentation with synthetic key transitions, without a window or a renderer.
+// Pipeline measures what a transition costs on its way through the input queue, the chord matcher and the latency ring.
+// EndToEnd runs the keybind thread against a render loop that presents at a fixed rate, and reports the latency percentiles the overlay would show.
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "InputLatency.h"
+#include "InputQueue.h"
+#include "KeybindMatcher.h"
+
+namespace {
+	constexpr A_U32 c_uFirstKey = 'A';
+	constexpr A_U32 c_uKeyCount = 26;
+
+	A_U64 GetTimestamp() noexcept { return static_cast<A_U64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()); }
+
+	// Binds every letter, some of them more than once, the way extensions bind keys with and without modifiers.
+	void Bind(_Inout_ Artemis::KeybindMatcher& refMatcher, _In_ A_U32 uKeybindCount) {
+		for (A_U32 i = 0; i < uKeybindCount; i++) {
+			Artemis::KeyModifiers Modifiers = i < c_uKeyCount ? Artemis::KeyModifiers::None : Artemis::KeyModifiers::Control;
+			refMatcher.Add(i, c_uFirstKey + i % c_uKeyCount, Modifiers, Artemis::KeybindTrigger::Press | Artemis::KeybindTrigger::Release, false);
+		}
+		refMatcher.Compile();
+	}
+
+	// What the keybind thread does with the transitions it takes from the queue, except for calling the keybinds.
+	void Handle(_Inout_ Artemis::InputQueue& refQueue, _Inout_ Artemis::KeybindMatcher& refMatcher, _Inout_ Artemis::InputLatency& refLatency) {
+		Artemis::InputEvent Event;
+		while (refQueue.Pop(Event))
+			refMatcher.Apply(Event);
+		refMatcher.Flush();
+
+		for (const Artemis::KeybindMatch& refMatch : refMatcher.GetMatches())
+			refLatency.Record("SyntheticKeybind", refMatch.uKey, Artemis::KeyModifiers::None, refMatch.uTimestamp, GetTimestamp());
+		refMatcher.ClearMatches();
+	}
+
+	// Argument: the number of keybinds.
+	void Pipeline(benchmark::State& refState) {
+		Artemis::InputQueue Queue;
+		Artemis::KeybindMatcher Matcher;
+		Artemis::InputLatency Latency;
+		Bind(Matcher, static_cast<A_U32>(refState.range(0)));
+
+		A_U32 uTransition = 0;
+		for (auto _ : refState) {
+			A_U32 uKey = c_uFirstKey + uTransition / 2 % c_uKeyCount;
+			Queue.Push({ GetTimestamp(), uKey, (uTransition & 1) == 0 });
+			uTransition++;
+
+			Handle(Queue, Matcher, Latency);
+
+			// A frame every few transitions keeps the ring of the latency instrumentation from filling up.
+			if (uTransition % 16 == 0) {
+				Latency.BeginFrame();
+				Latency.Present(GetTimestamp());
+			}
+		}
+
+		refState.SetItemsProcessed(refState.iterations());
+		refState.counters["dropped"] = static_cast<double>(Latency.GetDroppedCount());
+	}
+
+	// Arguments: the frames presented per second, and the average time between synthetic transitions in microseconds. Every iteration is a frame.
+	void EndToEnd(benchmark::State& refState) {
+		std::chrono::nanoseconds FrameTime(1000000000 / refState.range(0));
+		A_U32 uInterval = static_cast<A_U32>(refState.range(1));
+
+		Artemis::InputQueue Queue;
+		Artemis::KeybindMatcher Matcher;
+		Artemis::InputLatency Latency;
+		Bind(Matcher, c_uKeyCount);
+
+		std::atomic<bool> bRunning = true;
+
+		std::thread KeybindThread([&]() {
+			while (bRunning.load()) {
+				Handle(Queue, Matcher, Latency);
+				Queue.Wait();
+			}
+		});
+
+		std::thread InputThread([&]() {
+			std::mt19937 Generator(24);
+			std::uniform_int_distribution<A_U32> Keys(0, c_uKeyCount - 1);
+			std::uniform_int_distribution<A_U32> Intervals(uInterval / 2, uInterval * 3 / 2);
+
+			while (bRunning.load()) {
+				A_U32 uKey = c_uFirstKey + Keys(Generator);
+				Queue.Push({ GetTimestamp(), uKey, true });
+				std::this_thread::sleep_for(std::chrono::microseconds(Intervals(Generator)));
+				Queue.Push({ GetTimestamp(), uKey, false });
+				std::this_thread::sleep_for(std::chrono::microseconds(Intervals(Generator)));
+			}
+		});
+
+		// Presents on a fixed schedule, like a game limited to the frame rate, with the keybind calls recorded before each frame was started.
+		auto NextFrame = std::chrono::steady_clock::now();
+		for (auto _ : refState) {
+			Latency.BeginFrame();
+
+			NextFrame += FrameTime;
+			std::this_thread::sleep_until(NextFrame);
+
+			Latency.Present(GetTimestamp());
+		}
+
+		bRunning.store(false);
+		Queue.Interrupt();
+		InputThread.join();
+		KeybindThread.join();
+
+		const Artemis::LatencyHistogram& refTotal = Latency.GetTotal();
+
+		// The instrumentation only keeps the time to action per keybind, so the histograms of the keybinds are summed.
+		Artemis::LatencyHistogram ToAction;
+		for (const Artemis::BindingLatency& refBinding : Latency.GetBindings()) {
+			for (A_U32 i = 0; i < Artemis::LatencyHistogram::c_uBucketCount; i++)
+				ToAction.szuBuckets[i] += refBinding.ToAction.szuBuckets[i];
+			ToAction.uCount += refBinding.ToAction.uCount;
+			ToAction.uTotal += refBinding.ToAction.uTotal;
+			if (refBinding.ToAction.uMaximum > ToAction.uMaximum) ToAction.uMaximum = refBinding.ToAction.uMaximum;
+		}
+
+		refState.counters["actions"] = static_cast<double>(refTotal.uCount);
+		refState.counters["to action p50 (us)"] = static_cast<double>(ToAction.GetPercentile(0.5)) / 1000.0;
+		refState.counters["to action p99 (us)"] = static_cast<double>(ToAction.GetPercentile(0.99)) / 1000.0;
+		refState.counters["to present p50 (us)"] = static_cast<double>(refTotal.GetPercentile(0.5)) / 1000.0;
+		refState.counters["to present p99 (us)"] = static_cast<double>(refTotal.GetPercentile(0.99)) / 1000.0;
+		refState.counters["to present max (us)"] = static_cast<double>(refTotal.uMaximum) / 1000.0;
+		refState.counters["dropped"] = static_cast<double>(Latency.GetDroppedCount());
+	}
+}
+
+BENCHMARK(Pipeline)->Arg(26)->Arg(64);
+BENCHMARK(EndToEnd)->Args({ 240, 2000 })->Iterations(120)->UseRealTime();
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,178 @@
+// Compares invoking a manager, which calls every run of a concrete type through IInvocable::InvokeRange<T>, with the virtual call per object that Manager made before it grouped its objects by type.
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Manager.h"
+#include "Manager.inl"
+
+namespace {
+	// Shaped like IDraw: small objects of a few concrete types, each called once per frame.
+	class IShape {
+	public:
+		struct InvokeContext {
+			A_FL32* lpSum;
+		};
+
+		virtual ~IShape() = default;
+
+		virtual void Present(_In_ const InvokeContext& refContext) = 0;
+
+		constexpr A_I32 GetPriority() const noexcept { return 0; }
+
+		template<std::derived_from<IShape> T>
+		static void InvokeRange(_In_ const Artemis::InvocableRange<IShape>& refRange, _In_ const InvokeContext& refContext) {
+			for (A_U32 i = 0; i < refRange.uCount; i++) {
+				ARTEMIS_TIME_INVOCATION(refRange, i);
+				static_cast<T*>(refRange.ppObjects[i])->Present(refContext);
+			}
+		}
+	};
+
+	class Line final : public IShape {
+		A_FL32 fX1, fY1, fX2, fY2;
+
+	public:
+		Line(_In_ A_FL32 fSeed) noexcept : fX1(fSeed), fY1(fSeed * 2.0F), fX2(fSeed * 3.0F), fY2(fSeed * 4.0F) {}
+		void Present(_In_ const InvokeContext& refContext) override { *refContext.lpSum += std::abs(fX2 - fX1) + std::abs(fY2 - fY1); }
+	};
+
+	class Rectangle final : public IShape {
+		A_FL32 fX, fY, fWidth, fHeight;
+
+	public:
+		Rectangle(_In_ A_FL32 fSeed) noexcept : fX(fSeed), fY(fSeed), fWidth(fSeed * 0.5F), fHeight(fSeed * 0.25F) {}
+		void Present(_In_ const InvokeContext& refContext) override { *refContext.lpSum += fWidth * fHeight - fX * 0.5F; }
+	};
+
+	class Circle final : public IShape {
+		A_FL32 fX, fY, fRadius;
+
+	public:
+		Circle(_In_ A_FL32 fSeed) noexcept : fX(fSeed), fY(fSeed), fRadius(fSeed * 0.125F) {}
+		void Present(_In_ const InvokeContext& refContext) override { *refContext.lpSum += fRadius * fRadius * 3.14159265F + fY; }
+	};
+
+	class Label final : public IShape {
+		A_FL32 fX, fY;
+		A_U32 uValue;
+
+	public:
+		Label(_In_ A_FL32 fSeed) noexcept : fX(fSeed), fY(fSeed), uValue(static_cast<A_U32>(fSeed)) {}
+		void Present(_In_ const InvokeContext& refContext) override { *refContext.lpSum += static_cast<A_FL32>(uValue % 10) + fX; }
+	};
+
+	class ShapeManager : public Artemis::Manager<IShape> {
+	public:
+		void Present(_In_ const IShape::InvokeContext& refContext) const { InvokeAll(&refContext); }
+	};
+
+	// The concrete types in registration order, mixed the way extensions register their shapes.
+	std::vector<A_U32> GetTypes(_In_ A_U32 uCount) {
+		std::mt19937 Generator(uCount);
+		std::uniform_int_distribution<A_U32> Distribution(0, 3);
+
+		std::vector<A_U32> Types(uCount);
+		for (A_U32& refType : Types) refType = Distribution(Generator);
+		return Types;
+	}
+
+	template<class Callback>
+	void ForEachShape(_In_ A_U32 uCount, _In_ Callback&& fnCallback) {
+		std::vector<A_U32> Types = GetTypes(uCount);
+		for (A_U32 i = 0; i < uCount; i++)
+			fnCallback(Types[i], static_cast<A_FL32>(i % 1000) + 1.0F);
+	}
+
+	void VirtualDispatch(benchmark::State& refState) {
+		A_U32 uCount = static_cast<A_U32>(refState.range(0));
+
+		std::vector<std::unique_ptr<IShape>> Shapes;
+		ForEachShape(uCount, [&](A_U32 uType, A_FL32 fSeed) {
+			switch (uType) {
+			case 0: Shapes.push_back(std::make_unique<Line>(fSeed)); break;
+			case 1: Shapes.push_back(std::make_unique<Rectangle>(fSeed)); break;
+			case 2: Shapes.push_back(std::make_unique<Circle>(fSeed)); break;
+			default: Shapes.push_back(std::make_unique<Label>(fSeed)); break;
+			}
+		});
+
+		A_FL32 fSum = 0.0F;
+		const IShape::InvokeContext Context = { &fSum };
+
+		for (auto _ : refState) {
+			for (const std::unique_ptr<IShape>& refShape : Shapes)
+				refShape->Present(Context);
+			benchmark::DoNotOptimize(fSum);
+		}
+
+		refState.SetItemsProcessed(refState.iterations() * uCount);
+	}
+
+	// Heap allocated like VirtualDispatch, but added as their concrete type, so only the calls differ.
+	void ManagerAdd(benchmark::State& refState) {
+		A_U32 uCount = static_cast<A_U32>(refState.range(0));
+
+		ShapeManager Shapes;
+		ForEachShape(uCount, [&](A_U32 uType, A_FL32 fSeed) {
+			switch (uType) {
+			case 0: Shapes.Add(new Line(fSeed)); break;
+			case 1: Shapes.Add(new Rectangle(fSeed)); break;
+			case 2: Shapes.Add(new Circle(fSeed)); break;
+			default: Shapes.Add(new Label(fSeed)); break;
+			}
+
+			// As the render thread would between frames, so the snapshots superseded while adding are deleted before the measurement.
+			Shapes.Quiesce();
+		});
+
+		A_FL32 fSum = 0.0F;
+		const IShape::InvokeContext Context = { &fSum };
+
+		for (auto _ : refState) {
+			Shapes.Present(Context);
+			Shapes.Quiesce();
+			benchmark::DoNotOptimize(fSum);
+		}
+
+		refState.SetItemsProcessed(refState.iterations() * uCount);
+	}
+
+	// Constructed in the pool of the manager, as Emplace does.
+	void ManagerEmplace(benchmark::State& refState) {
+		A_U32 uCount = static_cast<A_U32>(refState.range(0));
+
+		ShapeManager Shapes;
+		ForEachShape(uCount, [&](A_U32 uType, A_FL32 fSeed) {
+			switch (uType) {
+			case 0: Shapes.Emplace<Line>(fSeed); break;
+			case 1: Shapes.Emplace<Rectangle>(fSeed); break;
+			case 2: Shapes.Emplace<Circle>(fSeed); break;
+			default: Shapes.Emplace<Label>(fSeed); break;
+			}
+
+			Shapes.Quiesce();
+		});
+
+		A_FL32 fSum = 0.0F;
+		const IShape::InvokeContext Context = { &fSum };
+
+		for (auto _ : refState) {
+			Shapes.Present(Context);
+			Shapes.Quiesce();
+			benchmark::DoNotOptimize(fSum);
+		}
+
+		refState.SetItemsProcessed(refState.iterations() * uCount);
+	}
+}
+
+BENCHMARK(VirtualDispatch)->Arg(64)->Arg(1024)->Arg(10240);
+BENCHMARK(ManagerAdd)->Arg(64)->Arg(1024)->Arg(10240);
+BENCHMARK(ManagerEmplace)->Arg(64)->Arg(1024)->Arg(10240);
+
+BENCHMARK_MAIN();
\ No newline at end of file
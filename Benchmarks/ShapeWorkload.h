@@ -0,0 +1,40 @@
+#ifndef __ARTEMIS_SHAPE_WORKLOAD_H__
+#define __ARTEMIS_SHAPE_WORKLOAD_H__
+
+#include <random>
+#include <vector>
+
+#include "DrawManager.h"
+
+namespace Artemis {
+	/// <summary>
+	/// Lines, rectangles, triangles and circles scattered over an area, half of them filled. The same count and area always give the same shapes.
+	/// </summary>
+	struct ShapeWorkload {
+		std::vector<Aurora::Line> Lines;
+		std::vector<Aurora::Rectangle> Rectangles;
+		std::vector<Aurora::Triangle> Triangles;
+		std::vector<Aurora::Circle> Circles;
+
+		ShapeWorkload(_In_ A_U32 uCount, _In_ const Bounds& refArea) {
+			std::mt19937 Generator(uCount);
+			std::uniform_int_distribution<A_I32> X(static_cast<A_I32>(refArea.fMinX), static_cast<A_I32>(refArea.fMaxX)), Y(static_cast<A_I32>(refArea.fMinY), static_cast<A_I32>(refArea.fMaxY)), Size(4, 40);
+			std::uniform_real_distribution<A_FL32> Channel(0.0F, 255.0F);
+
+			auto Color = [&]() { return Aurora::RGBA(Channel(Generator), Channel(Generator), Channel(Generator), 255.0F); };
+
+			for (A_U32 i = 0; i < uCount / 4; i++) {
+				Aurora::Point ptOrigin(X(Generator), Y(Generator));
+				A_I32 nSize = Size(Generator);
+				bool bFilled = i & 1;
+
+				Lines.emplace_back(ptOrigin, Aurora::Point(ptOrigin.x + nSize, ptOrigin.y + nSize / 2), Color(), 1.5F);
+				Rectangles.emplace_back(ptOrigin, Aurora::Point(ptOrigin.x + nSize, ptOrigin.y + nSize), Color(), bFilled, 1.0F);
+				Triangles.emplace_back(ptOrigin, Aurora::Point(ptOrigin.x + nSize, ptOrigin.y), Aurora::Point(ptOrigin.x, ptOrigin.y + nSize), Color(), bFilled, 1.0F);
+				Circles.emplace_back(ptOrigin, nSize, 0, Color(), bFilled, 1.0F);
+			}
+		}
+	};
+}
+
+#endif // !__ARTEMIS_SHAPE_WORKLOAD_H__
\ No newline at end of file
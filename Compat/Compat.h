@@ -0,0 +1,14 @@
+#ifndef __ARTEMIS_COMPAT_H__
+#define __ARTEMIS_COMPAT_H__
+
+// Stand-ins for the MSVC keywords the sources use, so the parts of Artemis that do not depend on Windows build with other compilers.
+// Forced into every translation unit of the CMake build when it is not built with MSVC.
+
+#define __int8 char
+#define __int16 short
+#define __int32 int
+#define __int64 long long
+
+#define __declspec(x)
+
+#endif // !__ARTEMIS_COMPAT_H__
\ No newline at end of file
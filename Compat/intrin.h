@@ -0,0 +1,8 @@
+#ifndef __ARTEMIS_COMPAT_INTRIN_H__
+#define __ARTEMIS_COMPAT_INTRIN_H__
+
+// The MSVC header of the compiler intrinsics, like __rdtsc.
+
+#include <x86intrin.h>
+
+#endif // !__ARTEMIS_COMPAT_INTRIN_H__
\ No newline at end of file
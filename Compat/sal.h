@@ -0,0 +1,32 @@
+#ifndef __ARTEMIS_COMPAT_SAL_H__
+#define __ARTEMIS_COMPAT_SAL_H__
+
+// The SAL annotations the sources use, which only mean something to the MSVC code analysis.
+
+#define _Check_return_
+#define _In_
+#define _In_opt_
+#define _In_opt_z_
+#define _In_z_
+#define _Inout_
+#define _Inout_opt_
+#define _Out_
+#define _Out_opt_
+#define _Printf_format_string_
+#define _Ret_maybenull_
+#define _Ret_notnull_
+#define _Ret_valid_
+#define _Ret_z_
+#define _Scanf_format_string_
+
+#define _In_range_(...)
+#define _In_reads_(...)
+#define _In_reads_bytes_(...)
+#define _Inout_updates_(...)
+#define _Out_writes_(...)
+#define _Out_writes_bytes_(...)
+#define _Out_writes_z_(...)
+#define _Ret_writes_(...)
+#define _When_(...)
+
+#endif // !__ARTEMIS_COMPAT_SAL_H__
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Conversions.h"
+
+namespace {
+	// Written independently of ChannelToU8: nearbyint rounds ties to even under the default rounding mode, like cvtps2dq.
+	A_U32 ReferencePack(_In_reads_(4) const A_FL32* pChannels) {
+		A_U32 uPacked = 0;
+		for (A_U32 i = 0; i < 4; i++) {
+			A_FL32 fChannel = pChannels[i];
+
+			A_U32 uByte = 0;
+			if (std::isnan(fChannel) || fChannel <= 0.0F) uByte = 0;
+			else if (fChannel >= 255.0F) uByte = 255;
+			else uByte = static_cast<A_U32>(std::nearbyint(fChannel));
+
+			uPacked |= uByte << (i * 8);
+		}
+		return uPacked;
+	}
+
+	// Channels around every tie and both ends of the range, then the values that stress saturation, then random values.
+	std::vector<A_FL32> GetChannels() {
+		std::vector<A_FL32> Channels;
+
+		for (A_I32 i = -8; i <= 520; i++) {
+			A_FL32 fHalf = static_cast<A_FL32>(i) * 0.5F;
+			Channels.push_back(fHalf);
+			Channels.push_back(std::nextafter(fHalf, -1000.0F));
+			Channels.push_back(std::nextafter(fHalf, 1000.0F));
+		}
+
+		const A_FL32 szfSpecial[] = {
+			-0.0F,
+			std::numeric_limits<A_FL32>::denorm_min(),
+			-std::numeric_limits<A_FL32>::denorm_min(),
+			std::numeric_limits<A_FL32>::quiet_NaN(),
+			-std::numeric_limits<A_FL32>::quiet_NaN(),
+			std::numeric_limits<A_FL32>::infinity(),
+			-std::numeric_limits<A_FL32>::infinity(),
+			std::numeric_limits<A_FL32>::max(),
+			std::numeric_limits<A_FL32>::lowest(),
+			2147483648.0F,
+			-2147483648.0F,
+			4294967296.0F,
+			65535.5F,
+			32767.5F
+		};
+		Channels.insert(Channels.end(), std::begin(szfSpecial), std::end(szfSpecial));
+
+		std::mt19937 Generator(9);
+		std::uniform_real_distribution<A_FL32> Distribution(-64.0F, 320.0F);
+		for (A_U32 i = 0; i < 4096; i++)
+			Channels.push_back(Distribution(Generator));
+
+		while (Channels.size() % 4) Channels.push_back(0.0F);
+		return Channels;
+	}
+
+	class ConversionTests : public testing::Test {
+	protected:
+		void SetUp() override {
+#if defined(__AVX2__) && (defined(__GNUC__) || defined(__clang__))
+			if (!__builtin_cpu_supports("avx2")) GTEST_SKIP() << "The processor does not support AVX2.";
+#endif // __AVX2__
+		}
+	};
+}
+
+TEST_F(ConversionTests, ChannelToU8MatchesTheReference) {
+	for (A_FL32 fChannel : GetChannels()) {
+		const A_FL32 szfChannels[4] = { fChannel, 0.0F, 0.0F, 0.0F };
+		EXPECT_EQ(static_cast<A_U32>(Artemis::Helpers::ChannelToU8(fChannel)), ReferencePack(szfChannels)) << fChannel;
+	}
+}
+
+TEST_F(ConversionTests, ChannelsToU32IsBitExact) {
+	std::vector<A_FL32> Channels = GetChannels();
+
+	// Counts that end in every tail of the vector loops, read both packed and from within larger structures.
+	for (size_t uStride : { 4 * sizeof(A_FL32), 5 * sizeof(A_FL32), 9 * sizeof(A_FL32) }) {
+		size_t uColorCount = Channels.size() / 4;
+
+		std::vector<A_BYTE> Colors(uColorCount * uStride);
+		for (size_t i = 0; i < uColorCount; i++)
+			memcpy(&Colors[i * uStride], &Channels[i * 4], 4 * sizeof(A_FL32));
+
+		for (size_t uCount : { size_t(0), size_t(1), size_t(3), size_t(4), size_t(7), size_t(8), size_t(9), size_t(15), size_t(17), uColorCount }) {
+			std::vector<A_U32> Packed(uCount + 1, 0xDEADBEEF);
+			Artemis::Helpers::ChannelsToU32(reinterpret_cast<const A_FL32*>(Colors.data()), Packed.data(), uCount, uStride);
+
+			for (size_t i = 0; i < uCount; i++)
+				ASSERT_EQ(Packed[i], ReferencePack(&Channels[i * 4])) << "color " << i << " of " << uCount << ", stride " << uStride;
+			EXPECT_EQ(Packed[uCount], 0xDEADBEEF);
+		}
+	}
+}
+
+TEST_F(ConversionTests, IntegersToFloatsIsBitExact) {
+	std::vector<A_I32> Integers = {
+		0, 1, -1,
+		(1 << 24) - 1, 1 << 24, (1 << 24) + 1, (1 << 24) + 3,
+		-(1 << 24) - 1, -(1 << 24) - 3,
+		std::numeric_limits<A_I32>::max(),
+		std::numeric_limits<A_I32>::min(),
+		std::numeric_limits<A_I32>::max() - 64
+	};
+
+	std::mt19937 Generator(10);
+	std::uniform_int_distribution<A_I32> Distribution(std::numeric_limits<A_I32>::min(), std::numeric_limits<A_I32>::max());
+	for (A_U32 i = 0; i < 4096; i++)
+		Integers.push_back(Distribution(Generator));
+
+	for (size_t uCount : { size_t(0), size_t(1), size_t(3), size_t(5), size_t(9), size_t(17), Integers.size() }) {
+		std::vector<A_FL32> Floats(uCount + 1, -1.0F);
+		Artemis::Helpers::IntegersToFloats(Integers.data(), Floats.data(), uCount);
+
+		for (size_t i = 0; i < uCount; i++) {
+			A_FL32 fExpected = static_cast<A_FL32>(Integers[i]);
+			ASSERT_EQ(memcmp(&Floats[i], &fExpected, sizeof(A_FL32)), 0) << Integers[i];
+		}
+		EXPECT_EQ(Floats[uCount], -1.0F);
+	}
+}
\ No newline at end of file
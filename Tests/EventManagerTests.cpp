@@ -0,0 +1,167 @@
+#include <chrono>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "EventManager.h"
+#include "Manager.inl"
+
+using Artemis::EventManager;
+using Artemis::EventSchedule;
+using Artemis::IEventEntry;
+
+namespace {
+	constexpr A_U64 c_uMillisecond = 1000000;
+
+	// Records the frames its condition was evaluated on.
+	class Recorder final : public IEventEntry {
+		const A_U64* lpFrame;
+
+	public:
+		std::vector<A_U64> Frames;
+
+		Recorder(_In_ const A_U64* lpFrame, _In_ EventSchedule Schedule) noexcept : IEventEntry(0, Schedule), lpFrame(lpFrame) {}
+
+		bool Condition() override {
+			Frames.push_back(*lpFrame);
+			return false;
+		}
+
+		void Invoke() override {}
+	};
+
+	// Runs frames at a fixed interval, starting from an arbitrary time.
+	class FrameClock {
+	public:
+		EventManager Manager;
+		A_U64 uFrame;
+		A_U64 uNow;
+
+		FrameClock() : uFrame(0), uNow(1000 * c_uMillisecond) {}
+
+		Recorder* Add(_In_ EventSchedule Schedule) { return static_cast<Recorder*>(Manager.Get(Manager.Emplace<Recorder>(&uFrame, Schedule))); }
+
+		void Run(_In_ A_U32 uFrames, _In_ A_U64 uInterval) {
+			for (A_U32 i = 0; i < uFrames; i++) {
+				uFrame++;
+				uNow += uInterval;
+				Manager.Invoke(uNow);
+				Manager.Quiesce();
+			}
+		}
+	};
+
+	std::vector<A_U64> Gaps(_In_ const std::vector<A_U64>& refFrames) {
+		std::vector<A_U64> Result;
+		for (size_t i = 1; i < refFrames.size(); i++)
+			Result.push_back(refFrames[i] - refFrames[i - 1]);
+		return Result;
+	}
+}
+
+template class Artemis::Manager<Artemis::IEventEntry>;
+
+TEST(EventManagerTests, FramePeriodsFireEveryNthFrame) {
+	FrameClock Clock;
+	Recorder* pEveryFrame = Clock.Add(EventSchedule::EveryFrame());
+	Recorder* pEveryFourth = Clock.Add(EventSchedule::EveryNthFrame(4));
+
+	Clock.Run(20, c_uMillisecond);
+
+	EXPECT_EQ(pEveryFrame->Frames.size(), 20U);
+	ASSERT_EQ(pEveryFourth->Frames.size(), 5U);
+	EXPECT_LE(pEveryFourth->Frames[0], 4U);
+	EXPECT_EQ(Gaps(pEveryFourth->Frames), (std::vector<A_U64>{ 4, 4, 4, 4 }));
+}
+
+TEST(EventManagerTests, MillisecondPeriodsFollowTheClock) {
+	FrameClock Clock;
+	Recorder* pEntry = Clock.Add(EventSchedule::Every(std::chrono::milliseconds(10)));
+
+	// At 1 ms a frame, the entry is due every tenth frame.
+	Clock.Run(100, c_uMillisecond);
+	ASSERT_EQ(pEntry->Frames.size(), 10U);
+	EXPECT_EQ(Gaps(pEntry->Frames), std::vector<A_U64>(9, 10));
+
+	// At 5 ms a frame, every other frame.
+	pEntry->Frames.clear();
+	Clock.Run(20, 5 * c_uMillisecond);
+	ASSERT_EQ(pEntry->Frames.size(), 10U);
+	EXPECT_EQ(Gaps(pEntry->Frames), std::vector<A_U64>(9, 2));
+}
+
+TEST(EventManagerTests, EqualPeriodsAreSpreadOverFrames) {
+	FrameClock Clock;
+
+	std::vector<Recorder*> Entries;
+	for (A_U32 i = 0; i < 8; i++)
+		Entries.push_back(Clock.Add(EventSchedule::EveryNthFrame(8)));
+
+	Clock.Run(16, c_uMillisecond);
+
+	// Each of the first eight frames gets one of the entries, and the next eight repeat them.
+	std::vector<bool> Taken(8, false);
+	for (Recorder* pEntry : Entries) {
+		ASSERT_EQ(pEntry->Frames.size(), 2U);
+		EXPECT_EQ(pEntry->Frames[1] - pEntry->Frames[0], 8U);
+
+		A_U64 uFirst = pEntry->Frames[0];
+		ASSERT_GE(uFirst, 1U);
+		ASSERT_LE(uFirst, 8U);
+		EXPECT_FALSE(Taken[uFirst - 1]);
+		Taken[uFirst - 1] = true;
+	}
+
+	EXPECT_EQ(Clock.Manager.GetStatistics().uMaxEvaluated, 1U);
+}
+
+TEST(EventManagerTests, PeriodsLongerThanTheWheelWrapAround) {
+	constexpr A_U32 c_uPeriod = EventManager::c_uWheelSize * 2 + 88;
+
+	FrameClock Clock;
+	Recorder* pFrames = Clock.Add(EventSchedule::EveryNthFrame(c_uPeriod));
+	Recorder* pTime = Clock.Add(EventSchedule::Every(std::chrono::milliseconds(c_uPeriod)));
+
+	Clock.Run(c_uPeriod * 3, c_uMillisecond);
+
+	ASSERT_EQ(pFrames->Frames.size(), 3U);
+	EXPECT_EQ(Gaps(pFrames->Frames), (std::vector<A_U64>{ c_uPeriod, c_uPeriod }));
+
+	ASSERT_EQ(pTime->Frames.size(), 3U);
+	EXPECT_EQ(Gaps(pTime->Frames), (std::vector<A_U64>{ c_uPeriod, c_uPeriod }));
+}
+
+TEST(EventManagerTests, StallsAreNotMadeUpFor) {
+	FrameClock Clock;
+	Recorder* pEntry = Clock.Add(EventSchedule::Every(std::chrono::milliseconds(10)));
+
+	Clock.Run(10, c_uMillisecond);
+	ASSERT_EQ(pEntry->Frames.size(), 1U);
+
+	// A frame that took five seconds, past a full turn of the wheel, only evaluates the entry once.
+	Clock.Run(1, 5000 * c_uMillisecond);
+	ASSERT_EQ(pEntry->Frames.size(), 2U);
+	EXPECT_EQ(pEntry->Frames[1], Clock.uFrame);
+
+	// And the entry goes on at its period from there.
+	Clock.Run(30, c_uMillisecond);
+	ASSERT_EQ(pEntry->Frames.size(), 5U);
+	EXPECT_EQ(Gaps(std::vector<A_U64>(pEntry->Frames.begin() + 2, pEntry->Frames.end())), (std::vector<A_U64>{ 10, 10 }));
+	EXPECT_LE(pEntry->Frames[2] - pEntry->Frames[1], 10U);
+}
+
+TEST(EventManagerTests, EvaluatedCountsTheDueEntries) {
+	FrameClock Clock;
+	Clock.Add(EventSchedule::EveryFrame());
+	for (A_U32 i = 0; i < 100; i++)
+		Clock.Add(EventSchedule::EveryNthFrame(100));
+
+	for (A_U32 i = 0; i < 200; i++) {
+		Clock.Run(1, c_uMillisecond);
+		ASSERT_EQ(Clock.Manager.GetStatistics().uEvaluated, 2U);
+	}
+
+	Artemis::EventSchedulerStatistics Statistics = Clock.Manager.GetStatistics();
+	EXPECT_EQ(Statistics.uRegistered, 101U);
+	EXPECT_EQ(Statistics.uMaxEvaluated, 2U);
+}
\ No newline at end of file
@@ -0,0 +1,271 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "EventQueue.h"
+
+using Aurora::EventHandlerAffinity;
+using Artemis::BackpressurePolicy;
+using Artemis::EventQueue;
+using Artemis::EventQueueStatistics;
+
+namespace {
+	struct ValueEventArgs {
+		A_U32 uValue;
+	};
+
+	using ValueEvent = Aurora::Event<ValueEventArgs>;
+
+	// Records the values an event is delivered with. Only called from one thread at a time.
+	class Recorder {
+	public:
+		std::vector<A_U32> Values;
+
+		void Subscribe(_Inout_ ValueEvent& refEvent, _In_ EventHandlerAffinity Affinity) {
+			refEvent.Subscribe([this](_In_opt_ A_LPVOID, _In_opt_ const ValueEventArgs* lpArgs) { Values.push_back(lpArgs->uValue); }, Affinity);
+		}
+	};
+
+	void Enqueue(_Inout_ EventQueue& refQueue, _In_ const ValueEvent& refEvent, _In_ A_U32 uValue) {
+		ValueEventArgs Args = { uValue };
+		ASSERT_TRUE(refQueue.Enqueue(refEvent, nullptr, &Args));
+	}
+}
+
+TEST(EventQueueTests, DropOldestDropsTheOldestWaitingEvents) {
+	ValueEvent Event;
+	Recorder Delivered;
+	Delivered.Subscribe(Event, EventHandlerAffinity::AnyThread);
+
+	// Not started, so nothing drains the queue until Stop.
+	EventQueue Queue(4, BackpressurePolicy::DropOldest);
+	for (A_U32 i = 0; i < 6; i++)
+		Enqueue(Queue, Event, i);
+
+	EventQueueStatistics Statistics = Queue.GetStatistics();
+	EXPECT_EQ(Statistics.uEnqueued, 6U);
+	EXPECT_EQ(Statistics.uDropped, 2U);
+	EXPECT_EQ(Statistics.uDepth, 4U);
+	EXPECT_EQ(Statistics.uMaxDepth, 4U);
+
+	Queue.Start();
+	Queue.Stop();
+
+	EXPECT_EQ(Delivered.Values, (std::vector<A_U32>{ 2, 3, 4, 5 }));
+
+	Statistics = Queue.GetStatistics();
+	EXPECT_EQ(Statistics.uDelivered, 4U);
+	EXPECT_EQ(Statistics.uDepth, 0U);
+}
+
+TEST(EventQueueTests, CoalesceDropsDistinctEventsOnAFullQueue) {
+	ValueEvent szEvents[6];
+	Recorder Delivered;
+	for (ValueEvent& refEvent : szEvents)
+		Delivered.Subscribe(refEvent, EventHandlerAffinity::AnyThread);
+
+	EventQueue Queue(4, BackpressurePolicy::Coalesce);
+	for (A_U32 i = 0; i < 6; i++)
+		Enqueue(Queue, szEvents[i], i);
+
+	Queue.Start();
+	Queue.Stop();
+
+	EXPECT_EQ(Delivered.Values, (std::vector<A_U32>{ 2, 3, 4, 5 }));
+
+	EventQueueStatistics Statistics = Queue.GetStatistics();
+	EXPECT_EQ(Statistics.uDropped, 2U);
+	EXPECT_EQ(Statistics.uCoalesced, 0U);
+	EXPECT_EQ(Statistics.uDelivered, 4U);
+}
+
+TEST(EventQueueTests, BlockWaitsForRoom) {
+	ValueEvent Event;
+	Recorder Delivered;
+
+	std::atomic<bool> bEntered = false;
+	std::atomic<bool> bRelease = false;
+
+	// Holds up the dispatch thread on the first event, so the queue fills up behind it.
+	Event.Subscribe([&](_In_opt_ A_LPVOID, _In_opt_ const ValueEventArgs* lpArgs) {
+		bEntered.store(true);
+		while (!bRelease.load()) std::this_thread::yield();
+		Delivered.Values.push_back(lpArgs->uValue);
+	}, EventHandlerAffinity::AnyThread);
+
+	EventQueue Queue(4, BackpressurePolicy::Block);
+	Queue.Start();
+
+	Enqueue(Queue, Event, 0);
+	while (!bEntered.load()) std::this_thread::yield();
+
+	for (A_U32 i = 1; i <= 4; i++)
+		Enqueue(Queue, Event, i);
+
+	std::atomic<bool> bEnqueued = false;
+	std::thread Producer([&]() {
+		Enqueue(Queue, Event, 5);
+		bEnqueued.store(true);
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	EXPECT_FALSE(bEnqueued.load());
+
+	bRelease.store(true);
+	Producer.join();
+	Queue.Stop();
+
+	EXPECT_EQ(Delivered.Values, (std::vector<A_U32>{ 0, 1, 2, 3, 4, 5 }));
+
+	EventQueueStatistics Statistics = Queue.GetStatistics();
+	EXPECT_EQ(Statistics.uDropped, 0U);
+	EXPECT_EQ(Statistics.uDelivered, 6U);
+}
+
+TEST(EventQueueTests, BlockDropsWhenNothingDrainsTheQueue) {
+	ValueEvent Event;
+	Recorder Delivered;
+	Delivered.Subscribe(Event, EventHandlerAffinity::AnyThread);
+
+	EventQueue Queue(4, BackpressurePolicy::Block);
+	for (A_U32 i = 0; i < 5; i++)
+		Enqueue(Queue, Event, i);
+
+	EXPECT_EQ(Queue.GetStatistics().uDropped, 1U);
+
+	Queue.Start();
+	Queue.Stop();
+
+	EXPECT_EQ(Delivered.Values, (std::vector<A_U32>{ 1, 2, 3, 4 }));
+}
+
+TEST(EventQueueTests, CoalesceDeliversOnlyTheNewestInvocation) {
+	ValueEvent First;
+	ValueEvent Second;
+	Recorder FirstDelivered;
+	Recorder SecondDelivered;
+	FirstDelivered.Subscribe(First, EventHandlerAffinity::AnyThread);
+	SecondDelivered.Subscribe(Second, EventHandlerAffinity::AnyThread);
+
+	EventQueue Queue(8, BackpressurePolicy::Coalesce);
+	Enqueue(Queue, First, 1);
+	Enqueue(Queue, Second, 10);
+	Enqueue(Queue, First, 2);
+	Enqueue(Queue, First, 3);
+
+	Queue.Start();
+	Queue.Stop();
+
+	EXPECT_EQ(FirstDelivered.Values, (std::vector<A_U32>{ 3 }));
+	EXPECT_EQ(SecondDelivered.Values, (std::vector<A_U32>{ 10 }));
+
+	EventQueueStatistics Statistics = Queue.GetStatistics();
+	EXPECT_EQ(Statistics.uEnqueued, 4U);
+	EXPECT_EQ(Statistics.uCoalesced, 2U);
+	EXPECT_EQ(Statistics.uDropped, 0U);
+	EXPECT_EQ(Statistics.uDelivered, 2U);
+}
+
+TEST(EventQueueTests, EvictingASupersededInvocationCountsAsCoalesced) {
+	ValueEvent First;
+	ValueEvent Second;
+	Recorder FirstDelivered;
+	Recorder SecondDelivered;
+	FirstDelivered.Subscribe(First, EventHandlerAffinity::AnyThread);
+	SecondDelivered.Subscribe(Second, EventHandlerAffinity::AnyThread);
+
+	EventQueue Queue(4, BackpressurePolicy::Coalesce);
+	for (A_U32 i = 0; i < 4; i++)
+		Enqueue(Queue, First, i);
+
+	// The oldest invocation of the first event is evicted, but a newer one is still waiting, so nothing is lost.
+	Enqueue(Queue, Second, 10);
+
+	EventQueueStatistics Statistics = Queue.GetStatistics();
+	EXPECT_EQ(Statistics.uDropped, 0U);
+	EXPECT_EQ(Statistics.uCoalesced, 1U);
+
+	Queue.Start();
+	Queue.Stop();
+
+	EXPECT_EQ(FirstDelivered.Values, (std::vector<A_U32>{ 3 }));
+	EXPECT_EQ(SecondDelivered.Values, (std::vector<A_U32>{ 10 }));
+	EXPECT_EQ(Queue.GetStatistics().uCoalesced, 3U);
+}
+
+TEST(EventQueueTests, RenderThreadHandlersWaitForDispatchDeferred) {
+	ValueEvent Mixed;
+	ValueEvent AnyThreadOnly;
+	Recorder MixedAnyThread;
+	Recorder MixedRenderThread;
+	Recorder AnyThreadOnlyDelivered;
+	MixedAnyThread.Subscribe(Mixed, EventHandlerAffinity::AnyThread);
+	MixedRenderThread.Subscribe(Mixed, EventHandlerAffinity::RenderThread);
+	AnyThreadOnlyDelivered.Subscribe(AnyThreadOnly, EventHandlerAffinity::AnyThread);
+
+	std::thread::id RenderThread;
+	Mixed.Subscribe([&](_In_opt_ A_LPVOID, _In_opt_ const ValueEventArgs*) { RenderThread = std::this_thread::get_id(); }, EventHandlerAffinity::RenderThread);
+
+	EventQueue Queue(8, BackpressurePolicy::DropOldest);
+	Enqueue(Queue, Mixed, 1);
+	Enqueue(Queue, AnyThreadOnly, 2);
+	Enqueue(Queue, Mixed, 3);
+
+	Queue.Start();
+	Queue.Stop();
+
+	EXPECT_EQ(MixedAnyThread.Values, (std::vector<A_U32>{ 1, 3 }));
+	EXPECT_EQ(AnyThreadOnlyDelivered.Values, (std::vector<A_U32>{ 2 }));
+	EXPECT_TRUE(MixedRenderThread.Values.empty());
+
+	// Invocations with render-thread handlers are only delivered once those have been called.
+	EXPECT_EQ(Queue.GetStatistics().uDelivered, 1U);
+
+	Queue.DispatchDeferred();
+
+	EXPECT_EQ(MixedRenderThread.Values, (std::vector<A_U32>{ 1, 3 }));
+	EXPECT_EQ(RenderThread, std::this_thread::get_id());
+	EXPECT_EQ(Queue.GetStatistics().uDelivered, 3U);
+
+	Queue.DispatchDeferred();
+	EXPECT_EQ(MixedRenderThread.Values.size(), 2U);
+}
+
+TEST(EventQueueTests, RenderThreadHandlersAreLeftToTheCallerWhenNotDeferred) {
+	ValueEvent Event;
+	Recorder Delivered;
+	Delivered.Subscribe(Event, EventHandlerAffinity::RenderThread);
+
+	EventQueue Queue(8, BackpressurePolicy::DropOldest);
+	ValueEventArgs Args = { 1 };
+	EXPECT_FALSE(Queue.Enqueue(Event, nullptr, &Args, false));
+	EXPECT_EQ(Queue.GetStatistics().uEnqueued, 0U);
+}
+
+TEST(EventQueueTests, StopDeliversEveryQueuedEvent) {
+	constexpr A_U32 c_uEventCount = 10000;
+
+	ValueEvent Event;
+	std::atomic<A_U64> uTotal = 0;
+	Event.Subscribe([&](_In_opt_ A_LPVOID, _In_opt_ const ValueEventArgs* lpArgs) { uTotal.fetch_add(lpArgs->uValue); }, EventHandlerAffinity::AnyThread);
+
+	// Blocks instead of dropping, and spreads the batches over the workers.
+	EventQueue Queue(64, BackpressurePolicy::Block);
+	Queue.Start(2);
+
+	for (A_U32 i = 1; i <= c_uEventCount; i++)
+		Enqueue(Queue, Event, i);
+	Queue.Stop();
+
+	EXPECT_EQ(uTotal.load(), static_cast<A_U64>(c_uEventCount) * (c_uEventCount + 1) / 2);
+
+	EventQueueStatistics Statistics = Queue.GetStatistics();
+	EXPECT_EQ(Statistics.uEnqueued, c_uEventCount);
+	EXPECT_EQ(Statistics.uDelivered, c_uEventCount);
+	EXPECT_EQ(Statistics.uDropped, 0U);
+	EXPECT_EQ(Statistics.uDepth, 0U);
+	EXPECT_LE(Statistics.uMaxDepth, 64U);
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Conversions.h"
+#include "FrameArena.h"
+#include "Manager.h"
+#include "Manager.inl"
+
+namespace {
+	std::atomic<A_U64> Allocations;
+}
+
+// Counts every allocation of the test process, so a frame can be checked for going to the heap.
+void* operator new(size_t uSize) {
+	Allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* lpMemory = std::malloc(uSize ? uSize : 1)) return lpMemory;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* lpMemory) noexcept { std::free(lpMemory); }
+void operator delete(void* lpMemory, size_t) noexcept { std::free(lpMemory); }
+
+namespace {
+	// Shaped like a draw with a dynamic polyline: converts a number of points that changes every frame into arena memory.
+	class IFrameTask {
+	public:
+		struct InvokeContext {
+			A_U32 uFrame;
+			A_FL32* lpSum;
+		};
+
+		virtual ~IFrameTask() = default;
+
+		virtual void Run(_In_ const InvokeContext& refContext) = 0;
+
+		constexpr A_I32 GetPriority() const noexcept { return 0; }
+
+		template<std::derived_from<IFrameTask> T>
+		static void InvokeRange(_In_ const Artemis::InvocableRange<IFrameTask>& refRange, _In_ const InvokeContext& refContext) {
+			for (A_U32 i = 0; i < refRange.uCount; i++)
+				static_cast<T*>(refRange.ppObjects[i])->Run(refContext);
+		}
+	};
+
+	class PolyLineTask final : public IFrameTask {
+		std::vector<A_I32> Coordinates;
+
+	public:
+		explicit PolyLineTask(_In_ A_U32 uPointCount) : Coordinates(uPointCount * 2) {
+			for (size_t i = 0; i < Coordinates.size(); i++)
+				Coordinates[i] = static_cast<A_I32>(i);
+		}
+
+		void Run(_In_ const InvokeContext& refContext) override {
+			size_t uCount = Coordinates.size() - (refContext.uFrame % 4) * 2;
+
+			A_FL32* pPoints = Artemis::FrameArena::Current().Allocate<A_FL32>(uCount);
+			Artemis::Helpers::IntegersToFloats(Coordinates.data(), pPoints, uCount);
+			*refContext.lpSum += pPoints[uCount - 1];
+		}
+	};
+
+	class TaskManager : public Artemis::Manager<IFrameTask> {
+	public:
+		// Runs one frame the way the present hook does: invoke, quiesce, then reset the arena.
+		void Frame(_In_ A_U32 uFrame, _Inout_ A_FL32& refSum) {
+			const InvokeContext Context = { uFrame, &refSum };
+			InvokeAll(&Context);
+			Quiesce();
+			Artemis::FrameArena::Current().Reset();
+		}
+	};
+}
+
+TEST(FrameArenaTests, SteadyStateFramesDoNotAllocate) {
+	TaskManager Tasks;
+	for (A_U32 i = 0; i < 64; i++)
+		Tasks.Emplace<PolyLineTask>(16 + i * 64);
+
+	// Together the tasks need more than one chunk, so the warm-up frames grow the arena and reclaim the snapshots superseded while emplacing.
+	A_FL32 fSum = 0.0F;
+	for (A_U32 i = 0; i < 4; i++)
+		Tasks.Frame(i, fSum);
+	ASSERT_GT(Artemis::FrameArena::Current().GetReservedSize(), Artemis::FrameArena::c_uChunkSize);
+
+	A_U64 uFirstAllocation = Allocations.load(std::memory_order_relaxed);
+	for (A_U32 i = 0; i < 256; i++)
+		Tasks.Frame(i, fSum);
+	A_U64 uAllocationCount = Allocations.load(std::memory_order_relaxed) - uFirstAllocation;
+
+	EXPECT_EQ(uAllocationCount, 0U);
+	EXPECT_GT(fSum, 0.0F);
+}
+
+TEST(FrameArenaTests, ResetKeepsTheChunks) {
+	Artemis::FrameArena Arena;
+
+	A_LPVOID lpFirst = Arena.Allocate(128, 16);
+	Arena.Allocate(Artemis::FrameArena::c_uChunkSize * 2, 64);
+	size_t uReservedSize = Arena.GetReservedSize();
+
+	Arena.Reset();
+
+	A_U64 uFirstAllocation = Allocations.load(std::memory_order_relaxed);
+	EXPECT_EQ(Arena.Allocate(128, 16), lpFirst);
+	Arena.Allocate(Artemis::FrameArena::c_uChunkSize * 2, 64);
+	EXPECT_EQ(Allocations.load(std::memory_order_relaxed) - uFirstAllocation, 0U);
+
+	EXPECT_EQ(Arena.GetReservedSize(), uReservedSize);
+}
\ No newline at end of file
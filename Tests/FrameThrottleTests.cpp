@@ -0,0 +1,99 @@
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "FrameThrottle.h"
+
+using Artemis::FrameDemand;
+using Artemis::FrameThrottle;
+using Artemis::FrameThrottleStatistics;
+
+namespace {
+	constexpr A_U64 c_uSecond = 1000000000;
+	constexpr A_U64 c_uMillisecond = 1000000;
+
+	struct Game {
+		A_U32 uFramesPerSecond;
+		A_U32 uSeconds;
+		A_U64 uJitter;		// The most a frame is presented early or late, in nanoseconds.
+		bool bInput;		// Whether input arrives before every frame.
+		FrameDemand Demand;	// What the draw layers and windows report on every frame.
+	};
+
+	// Presents the frames of a game through the throttle, from a start time in seconds.
+	FrameThrottleStatistics Present(_Inout_ FrameThrottle& refThrottle, _In_ const Game& refGame, _In_ A_U64 uStartSecond = 1000) {
+		std::mt19937_64 Generator(25);
+		std::uniform_int_distribution<A_U64> Jitter(0, 2 * refGame.uJitter);
+
+		const A_U64 uStart = uStartSecond * c_uSecond;
+		A_U64 uFrameCount = static_cast<A_U64>(refGame.uFramesPerSecond) * refGame.uSeconds;
+
+		for (A_U64 i = 1; i <= uFrameCount; i++) {
+			A_U64 uNow = uStart + i * c_uSecond / refGame.uFramesPerSecond + Jitter(Generator) - refGame.uJitter;
+
+			if (refGame.bInput) refThrottle.NotifyInput();
+			refThrottle.ShouldUpdate(uNow, refGame.Demand);
+		}
+
+		return refThrottle.GetStatistics();
+	}
+}
+
+TEST(FrameThrottleTests, StaticUiIsBuiltOnce) {
+	FrameThrottle Throttle;
+	FrameThrottleStatistics Statistics = Present(Throttle, { 300, 10, 0, false, FrameDemand::None });
+
+	EXPECT_EQ(Statistics.uBuiltFrames, 1U);
+	EXPECT_EQ(Statistics.uReplayedFrames, 2999U);
+}
+
+TEST(FrameThrottleTests, InputBuildsAtTheUpdateRate) {
+	FrameThrottle Throttle;
+	FrameThrottleStatistics Statistics = Present(Throttle, { 300, 10, 0, true, FrameDemand::None });
+
+	EXPECT_EQ(Statistics.uBuiltFrames, 600U);
+	EXPECT_EQ(Statistics.uReplayedFrames, 2400U);
+}
+
+TEST(FrameThrottleTests, DirtyUiBuildsAtTheUpdateRate) {
+	FrameThrottle Throttle;
+	FrameThrottleStatistics Statistics = Present(Throttle, { 144, 10, 0, false, FrameDemand::Dirty });
+
+	// Frames that do not line up with the update rate still keep to its cadence, rather than to every third frame.
+	EXPECT_EQ(Statistics.uBuiltFrames, 600U);
+	EXPECT_EQ(Statistics.uBuiltFrames + Statistics.uReplayedFrames, 1440U);
+}
+
+TEST(FrameThrottleTests, JitterAtTheUpdateRateBuildsEveryFrame) {
+	FrameThrottle Throttle;
+	FrameThrottleStatistics Statistics = Present(Throttle, { 60, 10, c_uMillisecond / 2, false, FrameDemand::Dirty });
+
+	EXPECT_EQ(Statistics.uBuiltFrames, 600U);
+	EXPECT_EQ(Statistics.uReplayedFrames, 0U);
+}
+
+TEST(FrameThrottleTests, RateZeroBuildsEveryFrame) {
+	FrameThrottle Throttle(0);
+	FrameThrottleStatistics Statistics = Present(Throttle, { 300, 10, 0, false, FrameDemand::None });
+
+	EXPECT_EQ(Statistics.uBuiltFrames, 3000U);
+	EXPECT_EQ(Statistics.uReplayedFrames, 0U);
+}
+
+TEST(FrameThrottleTests, EveryFrameDemandIgnoresTheUpdateRate) {
+	FrameThrottle Throttle;
+	FrameThrottleStatistics Statistics = Present(Throttle, { 240, 10, 0, false, FrameDemand::EveryFrame });
+
+	EXPECT_EQ(Statistics.uBuiltFrames, 2400U);
+	EXPECT_EQ(Statistics.uReplayedFrames, 0U);
+}
+
+TEST(FrameThrottleTests, RequestedUpdatesBuildOnce) {
+	FrameThrottle Throttle;
+	Present(Throttle, { 300, 1, 0, false, FrameDemand::None });
+
+	Throttle.RequestUpdate();
+	FrameThrottleStatistics Statistics = Present(Throttle, { 300, 1, 0, false, FrameDemand::None }, 1001);
+
+	EXPECT_EQ(Statistics.uBuiltFrames, 2U);
+}
\ No newline at end of file
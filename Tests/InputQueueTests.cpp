@@ -0,0 +1,108 @@
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "InputQueue.h"
+
+using Artemis::InputEvent;
+using Artemis::InputQueue;
+
+TEST(InputQueueTests, OverflowReleasesEveryKeyAfterTheQueuedTransitions) {
+	InputQueue Queue;
+
+	for (A_U32 i = 0; i < InputQueue::c_uCapacity; i++)
+		ASSERT_TRUE(Queue.Push({ i, 'A', (i & 1) == 0 }));
+
+	// The key-up is dropped, so the key would stay held if nothing released it.
+	EXPECT_FALSE(Queue.Push({ 1000, 'B', false }));
+	EXPECT_EQ(Queue.GetDroppedCount(), 1U);
+	EXPECT_FALSE(Queue.IsEmpty());
+
+	InputEvent Event;
+	for (A_U32 i = 0; i < InputQueue::c_uCapacity; i++) {
+		ASSERT_TRUE(Queue.Pop(Event));
+		EXPECT_EQ(Event.uKey, static_cast<A_U32>('A'));
+		EXPECT_EQ(Event.uTimestamp, i);
+	}
+
+	ASSERT_TRUE(Queue.Pop(Event));
+	EXPECT_EQ(Event.uKey, InputQueue::c_uAllKeys);
+	EXPECT_FALSE(Event.bDown);
+	EXPECT_EQ(Event.uTimestamp, 1000U);
+
+	EXPECT_FALSE(Queue.Pop(Event));
+	EXPECT_TRUE(Queue.IsEmpty());
+}
+
+TEST(InputQueueTests, TransitionsPushedAfterAnOverflowComeAfterTheRelease) {
+	InputQueue Queue;
+
+	for (A_U32 i = 0; i < InputQueue::c_uCapacity; i++)
+		ASSERT_TRUE(Queue.Push({ i, 'A', true }));
+	EXPECT_FALSE(Queue.Push({ 1000, 'B', false }));
+
+	InputEvent Event;
+	ASSERT_TRUE(Queue.Pop(Event));
+	ASSERT_TRUE(Queue.Push({ 2000, 'C', true }));
+
+	for (A_U32 i = 1; i < InputQueue::c_uCapacity; i++) {
+		ASSERT_TRUE(Queue.Pop(Event));
+		EXPECT_EQ(Event.uKey, static_cast<A_U32>('A'));
+	}
+
+	ASSERT_TRUE(Queue.Pop(Event));
+	EXPECT_EQ(Event.uKey, InputQueue::c_uAllKeys);
+	ASSERT_TRUE(Queue.Pop(Event));
+	EXPECT_EQ(Event.uKey, static_cast<A_U32>('C'));
+	EXPECT_FALSE(Queue.Pop(Event));
+}
+
+TEST(InputQueueTests, ConcurrentProducersKeepTheirOrder) {
+	constexpr A_U32 c_uProducerCount = 4;
+	constexpr A_U32 c_uTransitionCount = 20000;
+
+	InputQueue Queue;
+
+	std::vector<std::thread> Producers;
+	for (A_U32 i = 0; i < c_uProducerCount; i++) {
+		Producers.emplace_back([&Queue, i]() {
+			// Retried when full, so no transition is dropped and every one of them is seen.
+			for (A_U32 j = 0; j < c_uTransitionCount; j++)
+				while (!Queue.Push({ j, i + 1, true })) std::this_thread::yield();
+		});
+	}
+
+	A_U64 szuNext[c_uProducerCount] = {};
+	A_U64 uSeen = 0;
+	A_U64 uReleases = 0;
+
+	InputEvent Event;
+	while (uSeen < c_uProducerCount * c_uTransitionCount) {
+		if (!Queue.Pop(Event)) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		if (Event.uKey == InputQueue::c_uAllKeys) {
+			uReleases++;
+			continue;
+		}
+
+		ASSERT_GE(Event.uKey, 1U);
+		ASSERT_LE(Event.uKey, c_uProducerCount);
+		ASSERT_EQ(Event.uTimestamp, szuNext[Event.uKey - 1]++);
+		uSeen++;
+	}
+
+	for (std::thread& refProducer : Producers)
+		refProducer.join();
+
+	while (Queue.Pop(Event))
+		if (Event.uKey == InputQueue::c_uAllKeys) uReleases++;
+
+	// Every push that found the queue full asked for a release, but releases asked for before the last one was taken are merged into it.
+	EXPECT_LE(uReleases, Queue.GetDroppedCount());
+	EXPECT_EQ(uReleases > 0, Queue.GetDroppedCount() > 0);
+	EXPECT_TRUE(Queue.IsEmpty());
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "InputQueue.h"
+#include "KeybindMatcher.h"
+
+using Artemis::InputEvent;
+using Artemis::InputQueue;
+using Artemis::KeybindMatch;
+using Artemis::KeybindMatcher;
+using Artemis::KeybindTrigger;
+using Artemis::KeyModifiers;
+
+namespace {
+	constexpr A_U32 c_uLeftShift = 0xA0;
+	constexpr A_U32 c_uLeftControl = 0xA2;
+	constexpr A_U32 c_uShift = 0x10;
+	constexpr A_U32 c_uF5 = 0x74;
+
+	constexpr KeybindTrigger c_AllTriggers = KeybindTrigger::Press | KeybindTrigger::Release | KeybindTrigger::Repeat;
+
+	// Stands in for the window procedure: posts transitions into an input queue, which the keybind thread drains into the matcher.
+	class SyntheticInput {
+		InputQueue Queue;
+		A_U64 uTime;
+
+	public:
+		KeybindMatcher Matcher;
+
+		SyntheticInput() : uTime(0) {}
+
+		void Post(_In_ A_U32 uKey, _In_ bool bDown) { Queue.Push({ ++uTime, uKey, bDown }); }
+
+		void Post(_In_ std::initializer_list<std::pair<A_U32, bool>> Transitions) {
+			for (const std::pair<A_U32, bool>& refTransition : Transitions)
+				Post(refTransition.first, refTransition.second);
+		}
+
+		// Handles the transitions posted so far, like one tick of the keybind thread, and returns the chords that fired.
+		std::vector<KeybindMatch> Tick() {
+			InputEvent Event;
+			while (Queue.Pop(Event))
+				Matcher.Apply(Event);
+			Matcher.Flush();
+
+			std::vector<KeybindMatch> Matches = Matcher.GetMatches();
+			Matcher.ClearMatches();
+			return Matches;
+		}
+	};
+
+	using FiredList = std::vector<std::pair<A_U32, KeybindTrigger>>;
+
+	FiredList Fired(_In_ const std::vector<KeybindMatch>& refMatches) {
+		FiredList Result;
+		for (const KeybindMatch& refMatch : refMatches)
+			Result.emplace_back(refMatch.uBinding, refMatch.Trigger);
+		return Result;
+	}
+}
+
+TEST(KeybindMatcherTests, PressRepeatAndRelease) {
+	SyntheticInput Input;
+	Input.Matcher.Add(0, 'A', KeyModifiers::None, c_AllTriggers, false);
+	Input.Matcher.Compile();
+
+	Input.Post('A', true);
+	EXPECT_EQ(Fired(Input.Tick()), (FiredList{ { 0, KeybindTrigger::Press } }));
+
+	// The key repeat of the OS sends downs without ups.
+	Input.Post('A', true);
+	EXPECT_EQ(Fired(Input.Tick()), (FiredList{ { 0, KeybindTrigger::Repeat } }));
+
+	Input.Post('A', false);
+	EXPECT_EQ(Fired(Input.Tick()), (FiredList{ { 0, KeybindTrigger::Release } }));
+
+	EXPECT_TRUE(Input.Tick().empty());
+}
+
+TEST(KeybindMatcherTests, QuickTapWithinOneTickIsNotLost) {
+	SyntheticInput Input;
+	Input.Matcher.Add(0, 'A', KeyModifiers::None, c_AllTriggers, false);
+	Input.Matcher.Compile();
+
+	Input.Post({ { 'A', true }, { 'A', false }, { 'A', true }, { 'A', false } });
+	EXPECT_EQ(Fired(Input.Tick()), (FiredList{
+		{ 0, KeybindTrigger::Press },
+		{ 0, KeybindTrigger::Release },
+		{ 0, KeybindTrigger::Press },
+		{ 0, KeybindTrigger::Release }
+	}));
+}
+
+TEST(KeybindMatcherTests, ChordNeedsItsModifiers) {
+	SyntheticInput Input;
+	Input.Matcher.Add(0, c_uF5, KeyModifiers::Control | KeyModifiers::Shift, KeybindTrigger::Press, false);
+	Input.Matcher.Compile();
+
+	Input.Post({ { c_uF5, true }, { c_uF5, false } });
+	EXPECT_TRUE(Input.Tick().empty());
+
+	Input.Post({ { c_uLeftControl, true }, { c_uF5, true }, { c_uF5, false } });
+	EXPECT_TRUE(Input.Tick().empty());
+
+	// Ctrl+Shift+F5, posted in one tick, so the modifiers have to be committed before the key.
+	Input.Post({ { c_uLeftShift, true }, { c_uF5, true } });
+	std::vector<KeybindMatch> Matches = Input.Tick();
+	ASSERT_EQ(Fired(Matches), (FiredList{ { 0, KeybindTrigger::Press } }));
+	EXPECT_EQ(Matches[0].uKey, c_uF5);
+	EXPECT_EQ(Matches[0].uTimestamp, 7U);
+
+	EXPECT_TRUE(Input.Matcher.GetKeyboard().IsDown(c_uShift));
+}
+
+TEST(KeybindMatcherTests, ExclusiveChordsNeedExactlyTheirModifiers) {
+	SyntheticInput Input;
+	Input.Matcher.Add(0, c_uF5, KeyModifiers::Control, KeybindTrigger::Press, true);
+	Input.Matcher.Add(1, c_uF5, KeyModifiers::None, KeybindTrigger::Press, false);
+	Input.Matcher.Compile();
+
+	// Ctrl+F5 fires the exclusive chord, which keeps the plain F5 chord from firing.
+	Input.Post({ { c_uLeftControl, true }, { c_uF5, true }, { c_uF5, false } });
+	EXPECT_EQ(Fired(Input.Tick()), (FiredList{ { 0, KeybindTrigger::Press } }));
+
+	// With Shift held as well, only the plain chord fires.
+	Input.Post({ { c_uLeftShift, true }, { c_uF5, true }, { c_uF5, false } });
+	EXPECT_EQ(Fired(Input.Tick()), (FiredList{ { 1, KeybindTrigger::Press } }));
+}
+
+TEST(KeybindMatcherTests, ChordsWithMoreModifiersAreTriedFirst) {
+	SyntheticInput Input;
+	Input.Matcher.Add(0, c_uF5, KeyModifiers::None, KeybindTrigger::Press, false);
+	Input.Matcher.Add(1, c_uF5, KeyModifiers::Control, KeybindTrigger::Press, false);
+	Input.Matcher.Add(2, c_uF5, KeyModifiers::Control | KeyModifiers::Shift, KeybindTrigger::Press, true);
+	Input.Matcher.Compile();
+
+	Input.Post({ { c_uLeftControl, true }, { c_uF5, true }, { c_uF5, false } });
+	EXPECT_EQ(Fired(Input.Tick()), (FiredList{ { 1, KeybindTrigger::Press }, { 0, KeybindTrigger::Press } }));
+
+	Input.Post({ { c_uLeftShift, true }, { c_uF5, true } });
+	EXPECT_EQ(Fired(Input.Tick()), (FiredList{ { 2, KeybindTrigger::Press } }));
+}
+
+TEST(KeybindMatcherTests, ModifierKeysTriggerThroughTheirGenericKey) {
+	SyntheticInput Input;
+	Input.Matcher.Add(0, c_uShift, KeyModifiers::None, KeybindTrigger::Press | KeybindTrigger::Release, true);
+	Input.Matcher.Compile();
+
+	// The modifier a chord is triggered by is not one of its modifiers, so the exclusive chord still fires.
+	Input.Post(c_uLeftShift, true);
+	EXPECT_EQ(Fired(Input.Tick()), (FiredList{ { 0, KeybindTrigger::Press } }));
+
+	Input.Post(c_uLeftShift, false);
+	EXPECT_EQ(Fired(Input.Tick()), (FiredList{ { 0, KeybindTrigger::Release } }));
+}
+
+TEST(KeybindMatcherTests, OverflowReleasesHeldKeys) {
+	SyntheticInput Input;
+	Input.Matcher.Add(0, 'A', KeyModifiers::None, KeybindTrigger::Press | KeybindTrigger::Release, false);
+	Input.Matcher.Compile();
+
+	Input.Post('A', true);
+	for (A_U32 i = 1; i < InputQueue::c_uCapacity; i++)
+		Input.Post('B', true);
+
+	// The queue is full, so the key-up of A is dropped.
+	Input.Post('A', false);
+
+	EXPECT_EQ(Fired(Input.Tick()), (FiredList{ { 0, KeybindTrigger::Press }, { 0, KeybindTrigger::Release } }));
+	EXPECT_FALSE(Input.Matcher.GetKeyboard().IsDown('A'));
+	EXPECT_FALSE(Input.Matcher.GetKeyboard().IsDown('B'));
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Manager.h"
+#include "Manager.inl"
+
+namespace {
+	class ITest {
+		A_U32 uPhase;
+		A_I32 nPriority;
+
+	public:
+		struct InvokeContext {
+			std::vector<A_I32>* lpOrder;
+		};
+
+		constexpr ITest(_In_ A_U32 uPhase, _In_ A_I32 nPriority) noexcept : uPhase(uPhase), nPriority(nPriority) {}
+		virtual ~ITest() = default;
+
+		virtual void Invoke(_In_ const InvokeContext& refContext) = 0;
+
+		constexpr A_U32 GetPhase() const noexcept { return uPhase; }
+		constexpr A_I32 GetPriority() const noexcept { return nPriority; }
+
+		template<std::derived_from<ITest> T>
+		static void InvokeRange(_In_ const Artemis::InvocableRange<ITest>& refRange, _In_ const InvokeContext& refContext) {
+			for (A_U32 i = 0; i < refRange.uCount; i++)
+				static_cast<T*>(refRange.ppObjects[i])->Invoke(refContext);
+		}
+	};
+
+	// Records its id when invoked.
+	template<A_U32 uType>
+	class Recorder final : public ITest {
+		A_I32 nId;
+
+	public:
+		constexpr Recorder(_In_ A_I32 nId, _In_ A_U32 uPhase = 0, _In_ A_I32 nPriority = 0) noexcept : ITest(uPhase, nPriority), nId(nId) {}
+		void Invoke(_In_ const InvokeContext& refContext) override { refContext.lpOrder->push_back(nId); }
+	};
+
+	// Sets a flag when destroyed.
+	class Tracked final : public ITest {
+		bool* lpDestroyed;
+
+	public:
+		Tracked(_In_ bool* lpDestroyed) noexcept : ITest(0, 0), lpDestroyed(lpDestroyed) {}
+		~Tracked() override { *lpDestroyed = true; }
+
+		void Invoke(_In_ const InvokeContext&) override {}
+	};
+
+	class TestManager : public Artemis::Manager<ITest> {
+	public:
+		static constexpr A_U32 c_uPhaseCount = 2;
+
+		std::vector<A_I32> Invoke() {
+			std::vector<A_I32> Order;
+
+			InvokeContext szContexts[c_uPhaseCount];
+			for (InvokeContext& refContext : szContexts) refContext.lpOrder = &Order;
+
+			InvokeAll(szContexts);
+			Quiesce();
+			return Order;
+		}
+	};
+}
+
+TEST(ManagerTests, OrdersByPhaseThenPriority) {
+	TestManager Manager;
+	Manager.Emplace<Recorder<0>>(1, 1, -5);
+	Manager.Emplace<Recorder<0>>(2, 0, 10);
+	Manager.Emplace<Recorder<0>>(3, 0, -10);
+	Manager.Emplace<Recorder<0>>(4, 1, -10);
+
+	EXPECT_EQ(Manager.Invoke(), (std::vector<A_I32>{ 3, 2, 4, 1 }));
+}
+
+TEST(ManagerTests, OrdersEqualKeysByFirstRegistrationOfTheirType) {
+	TestManager Manager;
+	Manager.Emplace<Recorder<1>>(1);
+	Manager.Emplace<Recorder<0>>(2);
+	Manager.Emplace<Recorder<2>>(3);
+	Manager.Emplace<Recorder<0>>(4);
+	Manager.Add(new Recorder<1>(5));
+
+	// Add(ITest*) groups an object with the other objects invoked through the interface, which is a type of its own.
+	Manager.Add(static_cast<ITest*>(new Recorder<2>(6)));
+
+	EXPECT_EQ(Manager.Invoke(), (std::vector<A_I32>{ 1, 5, 2, 4, 3, 6 }));
+}
+
+TEST(ManagerTests, KeepsTheOrderOfTypesAcrossReleases) {
+	TestManager Manager;
+	Artemis::InvocableHandle<ITest> hFirst = Manager.Emplace<Recorder<1>>(1);
+	Manager.Emplace<Recorder<0>>(2);
+
+	Manager.Release(hFirst);
+	Manager.Emplace<Recorder<1>>(3);
+
+	EXPECT_EQ(Manager.Invoke(), (std::vector<A_I32>{ 3, 2 }));
+}
+
+TEST(ManagerTests, KeepsReleasedObjectsUntilQuiesced) {
+	bool bDestroyed = false;
+
+	TestManager Manager;
+	Artemis::InvocableHandle<ITest> hObject = Manager.Emplace<Tracked>(&bDestroyed);
+	Manager.Invoke();
+
+	// The invoking thread may still reference the object, since it has not quiesced since the release.
+	Manager.Release(hObject);
+	EXPECT_FALSE(bDestroyed);
+	EXPECT_EQ(Manager.Count(), 0U);
+
+	Manager.Quiesce();
+	EXPECT_TRUE(bDestroyed);
+}
+
+TEST(ManagerTests, SynchronizeReturnsOnceQuiesced) {
+	bool bDestroyed = false;
+
+	TestManager Manager;
+	Manager.Release(Manager.Emplace<Tracked>(&bDestroyed));
+
+	std::atomic<bool> bReturned = false;
+	std::thread Writer([&]() {
+		Manager.Synchronize();
+		bReturned.store(true);
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	EXPECT_FALSE(bReturned.load());
+
+	Manager.Quiesce();
+	Writer.join();
+
+	EXPECT_TRUE(bReturned.load());
+	EXPECT_TRUE(bDestroyed);
+}
+
+TEST(ManagerTests, StaleHandlesDoNotResolveToReusedSlots) {
+	bool bFirstDestroyed = false;
+	bool bSecondDestroyed = false;
+
+	TestManager Manager;
+	Artemis::InvocableHandle<ITest> hFirst = Manager.Emplace<Tracked>(&bFirstDestroyed);
+	Manager.Release(hFirst);
+	Manager.Quiesce();
+
+	Artemis::InvocableHandle<ITest> hSecond = Manager.Emplace<Tracked>(&bSecondDestroyed);
+	ASSERT_EQ(hSecond.uSlot, hFirst.uSlot);
+
+	EXPECT_EQ(Manager.Get(hFirst), nullptr);
+	EXPECT_NE(Manager.Get(hSecond), nullptr);
+
+	// Releasing through the stale handle leaves the object in the reused slot alone.
+	Manager.Release(hFirst);
+	Manager.Quiesce();
+	EXPECT_FALSE(bSecondDestroyed);
+	EXPECT_EQ(Manager.Count(), 1U);
+}
\ No newline at end of file
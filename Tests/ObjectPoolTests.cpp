@@ -0,0 +1,51 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ObjectPool.h"
+
+using Artemis::ObjectPool;
+
+TEST(ObjectPoolTests, KeepsOneBlockWhenTheLastCellIsFreed) {
+	ObjectPool Pool;
+
+	A_LPVOID lpFirst = Pool.Allocate(48, 8);
+	Pool.Free(lpFirst, 48, 8);
+	EXPECT_EQ(Pool.GetReservedSize(), ObjectPool::c_uBlockSize);
+
+	// Going between one object and none reuses the kept block instead of going to the heap.
+	for (A_U32 i = 0; i < 100; i++) {
+		A_LPVOID lpCell = Pool.Allocate(48, 8);
+		EXPECT_EQ(lpCell, lpFirst);
+		Pool.Free(lpCell, 48, 8);
+		EXPECT_EQ(Pool.GetReservedSize(), ObjectPool::c_uBlockSize);
+	}
+}
+
+TEST(ObjectPoolTests, ReturnsEveryOtherBlockWhenTheLastCellIsFreed) {
+	ObjectPool Pool;
+
+	constexpr A_U64 c_uCellSize = 4 * ObjectPool::c_uCacheLineSize;
+	constexpr A_U32 c_uCount = 3 * static_cast<A_U32>(ObjectPool::c_uBlockSize / c_uCellSize);
+
+	std::vector<A_LPVOID> Cells;
+	for (A_U32 i = 0; i < c_uCount; i++)
+		Cells.push_back(Pool.Allocate(c_uCellSize, 64));
+	EXPECT_EQ(Pool.GetReservedSize(), 3 * ObjectPool::c_uBlockSize);
+
+	for (A_U32 i = 1; i < c_uCount; i++)
+		Pool.Free(Cells[i], c_uCellSize, 64);
+	EXPECT_EQ(Pool.GetReservedSize(), 3 * ObjectPool::c_uBlockSize);
+
+	Pool.Free(Cells[0], c_uCellSize, 64);
+	EXPECT_EQ(Pool.GetReservedSize(), ObjectPool::c_uBlockSize);
+
+	// Every cell of the kept block is free again.
+	Cells.clear();
+	for (A_U32 i = 0; i < c_uCount / 3; i++)
+		Cells.push_back(Pool.Allocate(c_uCellSize, 64));
+	EXPECT_EQ(Pool.GetReservedSize(), ObjectPool::c_uBlockSize);
+
+	for (A_LPVOID lpCell : Cells)
+		Pool.Free(lpCell, c_uCellSize, 64);
+}
\ No newline at end of file